@@ -0,0 +1,294 @@
+#include "consumption_log.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+
+// File layout: the magic header, then records of
+//   int64 timestamp, int32 calories, double servings,
+//   uint32 userId length, uint32 foodId length, userId bytes, foodId bytes
+// Fixed-width fields are stored in host byte order.
+static const char LOG_MAGIC[8] = {'Y', 'A', 'D', 'A', 'L', 'O', 'G', '1'};
+static const long long SECONDS_PER_DAY = 86400;
+
+// Division that rounds towards negative infinity, so pre-1970 timestamps bucket correctly
+static long long floorDivide(long long value, long long divisor) {
+    long long quotient = value / divisor;
+    if ((value % divisor != 0) && ((value < 0) != (divisor < 0))) {
+        --quotient;
+    }
+    return quotient;
+}
+
+template <typename T>
+static void writeRaw(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+static bool readRaw(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+// Constructor
+ConsumptionLog::ConsumptionLog(const std::string& filename)
+    : logFilename(filename), lastTimestamp(std::numeric_limits<long long>::min()), entryCount(0) {
+    loadFromFile();
+}
+
+long long ConsumptionLog::dayOf(long long timestamp) {
+    return floorDivide(timestamp, SECONDS_PER_DAY);
+}
+
+long long ConsumptionLog::weekOf(long long timestamp) {
+    // Day 0 (1970-01-01) was a Thursday; shifting by 3 makes weeks start on Monday
+    return floorDivide(dayOf(timestamp) + 3, 7);
+}
+
+void ConsumptionLog::writeEntry(std::ostream& out, const ConsumptionEntry& entry) {
+    writeRaw<int64_t>(out, entry.timestamp);
+    writeRaw<int32_t>(out, entry.calories);
+    writeRaw<double>(out, entry.servings);
+    writeRaw<uint32_t>(out, static_cast<uint32_t>(entry.userId.size()));
+    writeRaw<uint32_t>(out, static_cast<uint32_t>(entry.foodId.size()));
+    out.write(entry.userId.data(), entry.userId.size());
+    out.write(entry.foodId.data(), entry.foodId.size());
+}
+
+bool ConsumptionLog::readEntry(std::istream& in, std::streamoff endOffset, ConsumptionEntry& entry, bool* corrupt) {
+    int64_t timestamp;
+    int32_t calories;
+    double servings;
+    uint32_t userLength;
+    uint32_t foodLength;
+    if (!readRaw(in, timestamp) || !readRaw(in, calories) || !readRaw(in, servings) ||
+        !readRaw(in, userLength) || !readRaw(in, foodLength)) {
+        return false;
+    }
+    
+    // Check the lengths before allocating: a damaged header must not trigger a huge resize
+    if (userLength > MAX_ID_LENGTH || foodLength > MAX_ID_LENGTH) {
+        if (corrupt) {
+            *corrupt = true;
+        }
+        return false;
+    }
+    std::streamoff position = in.tellg();
+    if (position < 0 || endOffset - position < static_cast<std::streamoff>(userLength) + foodLength) {
+        return false;
+    }
+    
+    entry.timestamp = timestamp;
+    entry.calories = calories;
+    entry.servings = servings;
+    entry.userId.resize(userLength);
+    entry.foodId.resize(foodLength);
+    if (!in.read(&entry.userId[0], userLength) || !in.read(&entry.foodId[0], foodLength)) {
+        return false;
+    }
+    return true;
+}
+
+// Log operations
+bool ConsumptionLog::loadFromFile() {
+    logStream.close();
+    dailyTotals.clear();
+    weeklyTotals.clear();
+    userDailyTotals.clear();
+    userWeeklyTotals.clear();
+    lastTimestamp = std::numeric_limits<long long>::min();
+    entryCount = 0;
+    
+    std::ifstream file(logFilename, std::ios::binary);
+    if (!file.is_open()) {
+        // A missing log is simply empty; it is created on the first append
+        return openForAppend();
+    }
+    
+    char magic[sizeof(LOG_MAGIC)];
+    if (!file.read(magic, sizeof(magic))) {
+        // Empty or truncated header: start the log afresh
+        file.close();
+        std::filesystem::resize_file(logFilename, 0);
+        return openForAppend();
+    }
+    if (std::memcmp(magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0) {
+        std::cerr << "Error: '" << logFilename << "' is not a consumption log." << std::endl;
+        return false;
+    }
+    
+    std::streamoff fileEnd = static_cast<std::streamoff>(std::filesystem::file_size(logFilename));
+    std::streamoff validEnd = file.tellg();
+    ConsumptionEntry entry;
+    bool corrupt = false;
+    while (readEntry(file, fileEnd, entry, &corrupt)) {
+        // readEntries relies on time order, as append enforces, so an out-of-order record is damage
+        if (entry.timestamp < lastTimestamp) {
+            corrupt = true;
+            break;
+        }
+        applyToAggregates(entry);
+        lastTimestamp = entry.timestamp;
+        ++entryCount;
+        validEnd = file.tellg();
+    }
+    file.close();
+    
+    // Truncating here would throw away every record after the damaged one
+    if (corrupt) {
+        std::cerr << "Error: Consumption log '" << logFilename << "' is corrupt after "
+                  << entryCount << " entries." << std::endl;
+        return false;
+    }
+    
+    // Drop a record left half-written by a crash so later appends stay aligned
+    if (validEnd != fileEnd) {
+        std::cerr << "Warning: Discarding incomplete record at the end of '" << logFilename << "'." << std::endl;
+        std::filesystem::resize_file(logFilename, static_cast<std::uintmax_t>(validEnd));
+    }
+    
+    return openForAppend();
+}
+
+bool ConsumptionLog::openForAppend() {
+    bool isNew = !std::filesystem::exists(logFilename) || std::filesystem::file_size(logFilename) == 0;
+    logStream.open(logFilename, std::ios::binary | std::ios::app);
+    if (!logStream.is_open()) {
+        std::cerr << "Error: Could not open consumption log '" << logFilename << "' for writing." << std::endl;
+        return false;
+    }
+    if (isNew) {
+        logStream.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+        logStream.flush();
+    }
+    return true;
+}
+
+bool ConsumptionLog::logConsumption(const FoodDatabase& db, const std::string& userId, const std::string& foodId,
+                                    double servings, long long timestamp) {
+    if (!std::isfinite(servings) || servings <= 0) {
+        std::cerr << "Error: Servings must be a positive number." << std::endl;
+        return false;
+    }
+    
+    const Food* food = db.getFood(foodId);
+    if (!food) {
+        std::cerr << "Error: Food '" << foodId << "' not found." << std::endl;
+        return false;
+    }
+    
+    // Round in double precision first so an oversized total is caught instead of wrapping
+    double calories = std::round(servings * food->getCaloriesPerServing());
+    if (!(calories >= std::numeric_limits<int>::min() && calories <= std::numeric_limits<int>::max())) {
+        std::cerr << "Error: Calorie total for " << servings << " servings of '" << foodId
+                  << "' is too large to log." << std::endl;
+        return false;
+    }
+    
+    ConsumptionEntry entry;
+    entry.timestamp = timestamp;
+    entry.userId = userId;
+    entry.foodId = foodId;
+    entry.servings = servings;
+    entry.calories = static_cast<int>(calories);
+    return append(entry);
+}
+
+bool ConsumptionLog::append(const ConsumptionEntry& entry) {
+    if (entry.timestamp < lastTimestamp) {
+        std::cerr << "Error: Consumption entries must be logged in time order." << std::endl;
+        return false;
+    }
+    if (entry.userId.size() > MAX_ID_LENGTH || entry.foodId.size() > MAX_ID_LENGTH) {
+        std::cerr << "Error: User and food identifiers are limited to " << MAX_ID_LENGTH << " bytes." << std::endl;
+        return false;
+    }
+    if (!logStream.is_open()) {
+        std::cerr << "Error: Consumption log '" << logFilename << "' is not open for writing." << std::endl;
+        return false;
+    }
+    
+    writeEntry(logStream, entry);
+    logStream.flush();
+    if (!logStream) {
+        std::cerr << "Error: Could not write to consumption log '" << logFilename << "'." << std::endl;
+        return false;
+    }
+    
+    applyToAggregates(entry);
+    lastTimestamp = entry.timestamp;
+    ++entryCount;
+    return true;
+}
+
+void ConsumptionLog::applyToAggregates(const ConsumptionEntry& entry) {
+    long long day = dayOf(entry.timestamp);
+    long long week = weekOf(entry.timestamp);
+    dailyTotals[day] += entry.calories;
+    weeklyTotals[week] += entry.calories;
+    userDailyTotals[entry.userId][day] += entry.calories;
+    userWeeklyTotals[entry.userId][week] += entry.calories;
+}
+
+std::vector<ConsumptionEntry> ConsumptionLog::readEntries(long long fromTimestamp, long long toTimestamp) const {
+    std::vector<ConsumptionEntry> result;
+    std::ifstream file(logFilename, std::ios::binary);
+    if (!file.is_open() || !file.seekg(sizeof(LOG_MAGIC))) {
+        return result;
+    }
+    
+    // The log is time-ordered, so reading stops at the first entry past the range
+    std::error_code error;
+    std::streamoff fileEnd = static_cast<std::streamoff>(std::filesystem::file_size(logFilename, error));
+    if (error) {
+        return result;
+    }
+    
+    ConsumptionEntry entry;
+    while (readEntry(file, fileEnd, entry) && entry.timestamp <= toTimestamp) {
+        if (entry.timestamp >= fromTimestamp) {
+            result.push_back(entry);
+        }
+    }
+    return result;
+}
+
+// Aggregate queries
+long long ConsumptionLog::sumBuckets(const std::map<long long, long long>& buckets, long long first, long long last) {
+    long long total = 0;
+    for (auto it = buckets.lower_bound(first); it != buckets.end() && it->first <= last; ++it) {
+        total += it->second;
+    }
+    return total;
+}
+
+long long ConsumptionLog::getCaloriesForDays(long long firstDay, long long lastDay) const {
+    return sumBuckets(dailyTotals, firstDay, lastDay);
+}
+
+long long ConsumptionLog::getCaloriesForWeeks(long long firstWeek, long long lastWeek) const {
+    return sumBuckets(weeklyTotals, firstWeek, lastWeek);
+}
+
+long long ConsumptionLog::getUserCaloriesForDays(const std::string& userId, long long firstDay, long long lastDay) const {
+    auto found = userDailyTotals.find(userId);
+    if (found == userDailyTotals.end()) {
+        return 0;
+    }
+    return sumBuckets(found->second, firstDay, lastDay);
+}
+
+long long ConsumptionLog::getUserCaloriesForWeeks(const std::string& userId, long long firstWeek, long long lastWeek) const {
+    auto found = userWeeklyTotals.find(userId);
+    if (found == userWeeklyTotals.end()) {
+        return 0;
+    }
+    return sumBuckets(found->second, firstWeek, lastWeek);
+}
+
+// Other operations
+size_t ConsumptionLog::size() const {
+    return entryCount;
+}
\ No newline at end of file
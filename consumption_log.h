@@ -0,0 +1,81 @@
+#ifndef CONSUMPTION_LOG_H
+#define CONSUMPTION_LOG_H
+
+#include "food_database.h"
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One record of something eaten
+struct ConsumptionEntry {
+    long long timestamp;   // Seconds since the Unix epoch (UTC)
+    std::string userId;
+    std::string foodId;
+    double servings;
+    int calories;          // Calories for the whole entry, fixed at the time it was logged
+};
+
+// Append-only, time-ordered binary log of consumption entries.
+// Per-day and per-week calorie totals (overall and per user) are updated on every append,
+// so range queries cost one step per bucket rather than one per entry.
+class ConsumptionLog {
+private:
+    std::string logFilename;
+    std::ofstream logStream;
+    long long lastTimestamp;
+    size_t entryCount;
+    
+    // Calorie totals keyed by day / week number since the epoch
+    std::map<long long, long long> dailyTotals;
+    std::map<long long, long long> weeklyTotals;
+    std::unordered_map<std::string, std::map<long long, long long>> userDailyTotals;
+    std::unordered_map<std::string, std::map<long long, long long>> userWeeklyTotals;
+    
+    // Helper methods
+    void applyToAggregates(const ConsumptionEntry& entry);
+    bool openForAppend();
+    static void writeEntry(std::ostream& out, const ConsumptionEntry& entry);
+    // Stops at endOffset; sets *corrupt when the record is damaged rather than just cut short
+    static bool readEntry(std::istream& in, std::streamoff endOffset, ConsumptionEntry& entry, bool* corrupt = nullptr);
+    static long long sumBuckets(const std::map<long long, long long>& buckets, long long first, long long last);
+    
+public:
+    // Longest user or food identifier a record may hold
+    static const size_t MAX_ID_LENGTH = 64 * 1024;
+    
+    // Constructor (loads the existing log and rebuilds the aggregates)
+    ConsumptionLog(const std::string& filename = "consumption.log");
+    
+    // The log owns an open append stream, so it cannot be copied
+    ConsumptionLog(const ConsumptionLog&) = delete;
+    ConsumptionLog& operator=(const ConsumptionLog&) = delete;
+    
+    // Log operations
+    // Fails, leaving the file untouched, when a record is damaged or out of time order
+    bool loadFromFile();
+    // Looks the food up in the database and records servings * caloriesPerServing;
+    // servings must be finite and positive and the total must fit in an int
+    bool logConsumption(const FoodDatabase& db, const std::string& userId, const std::string& foodId,
+                        double servings, long long timestamp);
+    // Entries must arrive in time order; an entry older than the last one is rejected,
+    // as are identifiers longer than MAX_ID_LENGTH bytes
+    bool append(const ConsumptionEntry& entry);
+    std::vector<ConsumptionEntry> readEntries(long long fromTimestamp, long long toTimestamp) const;
+    
+    // Aggregate queries (day and week ranges are inclusive)
+    long long getCaloriesForDays(long long firstDay, long long lastDay) const;
+    long long getCaloriesForWeeks(long long firstWeek, long long lastWeek) const;
+    long long getUserCaloriesForDays(const std::string& userId, long long firstDay, long long lastDay) const;
+    long long getUserCaloriesForWeeks(const std::string& userId, long long firstWeek, long long lastWeek) const;
+    
+    // Bucket numbering (weeks start on Monday)
+    static long long dayOf(long long timestamp);
+    static long long weekOf(long long timestamp);
+    
+    // Other operations
+    size_t size() const;
+};
+
+#endif // CONSUMPTION_LOG_H
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "food.h"
 #include <sstream>
 #include <algorithm>
+#include <stdexcept>
 
 // Default constructor
 Food::Food() : identifier(""), caloriesPerServing(0), isComposite(false) {}
@@ -35,11 +36,11 @@ Food::Food(const std::string& id, const std::vector<Food>& comps)
 }
 
 // Getters
-std::string Food::getIdentifier() const {
+const std::string& Food::getIdentifier() const {
     return identifier;
 }
 
-std::vector<std::string> Food::getKeywords() const {
+const std::vector<std::string>& Food::getKeywords() const {
     return keywords;
 }
 
@@ -204,4 +205,39 @@ Food Food::fromString(const std::string& str) {
     // Components need to be added after all foods are loaded from file
     
     return food;
+}
+
+Food Food::fromPipeString(const std::string& str) {
+    std::stringstream ss(str);
+    std::string token;
+    std::vector<std::string> tokens;
+    
+    // Split the string by pipes
+    while (std::getline(ss, token, '|')) {
+        tokens.push_back(token);
+    }
+    
+    // Check required tokens
+    if (tokens.size() < 3) {
+        // Invalid format, return empty food
+        return Food();
+    }
+    
+    // Parse keywords (split by commas)
+    std::vector<std::string> kw;
+    std::stringstream kwStream(tokens[1]);
+    std::string keyword;
+    while (std::getline(kwStream, keyword, ',')) {
+        kw.push_back(keyword);
+    }
+    
+    // Feed rows are untrusted, so a bad calorie count skips the row
+    int calories = 0;
+    try {
+        calories = std::stoi(tokens[2]);
+    } catch (const std::exception&) {
+        return Food();
+    }
+    
+    return Food(tokens[0], kw, calories);
 }
\ No newline at end of file
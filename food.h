@@ -20,8 +20,8 @@ public:
     Food(const std::string& id, const std::vector<Food>& components);
     
     // Getters
-    std::string getIdentifier() const;
-    std::vector<std::string> getKeywords() const;
+    const std::string& getIdentifier() const;
+    const std::vector<std::string>& getKeywords() const;
     int getCaloriesPerServing() const;
     bool getIsComposite() const;
     const std::vector<Food>& getComponents() const;
@@ -41,6 +41,8 @@ public:
     // For file operations
     std::string toString() const;
     static Food fromString(const std::string& str);
+    // Parses the pipe-delimited feed layout: identifier|keyword1,keyword2,...|calories
+    static Food fromPipeString(const std::string& str);
 };
 
 #endif // FOOD_H
\ No newline at end of file
@@ -2,30 +2,136 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <cstdio>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+// Marks a slot that currently holds no food
+static const size_t NO_POSITION = static_cast<size_t>(-1);
+
+// Foods per storage chunk: the most a write during a background save has to copy
+static const size_t FOODS_PER_CHUNK = 1024;
+
+// Pipe-delimited feeds never contain semicolons; everything else is the native layout
+static FoodFileFormat detectFormat(const std::string& line) {
+    if (line.find('|') != std::string::npos && line.find(';') == std::string::npos) {
+        return FoodFileFormat::Pipe;
+    }
+    return FoodFileFormat::Semicolon;
+}
 
 // Constructor
-FoodDatabase::FoodDatabase(const std::string& filename) : databaseFilename(filename) {
-    loadFromFile();
+FoodDatabase::FoodDatabase(const std::string& filename, bool autoLoad)
+    : databaseFilename(filename), duplicateRows(0) {
+    if (autoLoad) {
+        loadFromFile();
+    }
+}
+
+FoodDatabase::FoodDatabase(const FoodDatabase& other)
+    : chunkShared(other.chunks.size(), false), databaseFilename(other.databaseFilename),
+      pendingSave(other.pendingSave), positionSlots(other.positionSlots), slotPositions(other.slotPositions),
+      freeSlots(other.freeSlots), identifierIndex(other.identifierIndex), keywordIndex(other.keywordIndex),
+      duplicateRows(other.duplicateRows) {
+    // Chunks are copied rather than shared: copy-on-write only covers background saves
+    chunks.reserve(other.chunks.size());
+    for (const auto& chunk : other.chunks) {
+        auto copy = std::make_shared<FoodChunk>();
+        copy->reserve(FOODS_PER_CHUNK);
+        copy->assign(chunk->begin(), chunk->end());
+        chunks.push_back(copy);
+    }
+    if (other.similarityIndex) {
+        similarityIndex.reset(new FoodSimilarityIndex(*other.similarityIndex));
+    }
+}
+
+FoodDatabase& FoodDatabase::operator=(const FoodDatabase& other) {
+    if (this != &other) {
+        FoodDatabase copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
 }
 
 // Database operations
 bool FoodDatabase::loadFromFile() {
+    std::vector<CompositeRelation> compositeRelations;
+    if (!loadFromFile(compositeRelations)) {
+        return false;
+    }
+    
+    // Process composite relations after all foods are loaded
+    if (!compositeRelations.empty()) {
+        processCompositeRelations(compositeRelations);
+    }
+    
+    return true;
+}
+
+bool FoodDatabase::loadFromFile(std::vector<CompositeRelation>& compositeRelations) {
     std::ifstream file(databaseFilename);
     if (!file.is_open()) {
         std::cerr << "Warning: Could not open database file '" << databaseFilename << "' for reading." << std::endl;
         return false;
     }
     
-    foods.clear();
+    std::vector<Food> loaded;
+    parseFoodRows(file, FoodFileFormat::Auto, loaded, compositeRelations);
+    file.close();
+    
+    replaceFoods(std::move(loaded));
+    rebuildIndexes();
+    rebuildSimilarityIndex();
+    
+    return true;
+}
+
+size_t FoodDatabase::parseFoodRows(std::istream& input, FoodFileFormat format,
+                                   std::vector<Food>& rows, std::vector<CompositeRelation>& compositeRelations) {
     std::string line;
-    std::vector<CompositeRelation> compositeRelations;
+    size_t skippedRows = 0;
     
-    while (std::getline(file, line)) {
+    while (std::getline(input, line)) {
+        // Tolerate files written with Windows line endings
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        
         // Skip empty lines and comments
         if (line.empty() || line[0] == '#') {
             continue;
         }
         
+        if (format == FoodFileFormat::Auto) {
+            format = detectFormat(line);
+        }
+        
+        if (format == FoodFileFormat::Pipe) {
+            Food food = Food::fromPipeString(line);
+            if (food.getIdentifier().empty()) {
+                ++skippedRows;
+                continue;
+            }
+            rows.push_back(std::move(food));
+            continue;
+        }
+        
+        // Load the food (initially as basic food); feed rows are untrusted,
+        // so a row whose calories do not parse is skipped rather than aborting the batch
+        Food food;
+        try {
+            food = Food::fromString(line);
+        } catch (const std::exception&) {
+            ++skippedRows;
+            continue;
+        }
+        if (food.getIdentifier().empty()) {
+            ++skippedRows;
+            continue;
+        }
+        
         // Split the line to extract composite food information
         std::stringstream ss(line);
         std::string token;
@@ -50,28 +156,140 @@ bool FoodDatabase::loadFromFile() {
             compositeRelations.push_back(relation);
         }
         
-        // Load the food (initially as basic food)
-        Food food = Food::fromString(line);
-        if (!food.getIdentifier().empty()) {
-            foods.push_back(food);
+        rows.push_back(std::move(food));
+    }
+    
+    if (skippedRows > 0) {
+        std::cerr << "Warning: Skipped " << skippedRows << " malformed rows." << std::endl;
+    }
+    return skippedRows;
+}
+
+bool FoodDatabase::importFromFile(const std::string& filename, FoodFileFormat format, size_t* skippedRows) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Warning: Could not open import file '" << filename << "' for reading." << std::endl;
+        return false;
+    }
+    
+    importFromStream(file, format, skippedRows);
+    return true;
+}
+
+size_t FoodDatabase::importFromStream(std::istream& input, FoodFileFormat format, size_t* skippedRows) {
+    std::vector<Food> batch;
+    std::vector<CompositeRelation> compositeRelations;
+    size_t skipped = parseFoodRows(input, format, batch, compositeRelations);
+    if (skippedRows) {
+        *skippedRows = skipped;
+    }
+    
+    size_t imported = batch.size();
+    appendFoods(std::move(batch), compositeRelations);
+    return imported;
+}
+
+void FoodDatabase::appendFoods(std::vector<Food> batch, const std::vector<CompositeRelation>& relations) {
+    if (batch.empty() && relations.empty()) {
+        return;
+    }
+    
+    // One pass folds duplicates into the earliest food with that identifier, matching what
+    // repeated addFood calls would produce; keywords are indexed once at the end
+    for (auto& food : batch) {
+        if (food.getIdentifier().empty()) {
+            continue;
+        }
+        
+        auto existing = identifierIndex.find(food.getIdentifier());
+        if (existing != identifierIndex.end()) {
+            writableFood(existing->second) = std::move(food);
+            continue;
         }
+        
+        std::string identifier = food.getIdentifier();
+        size_t slot = appendFood(std::move(food));
+        identifierIndex.emplace(std::move(identifier), slot);
     }
     
-    file.close();
+    rebuildIndexes();
+    rebuildSimilarityIndex();
     
-    // Process composite relations after all foods are loaded
-    if (!compositeRelations.empty()) {
-        processCompositeRelations(compositeRelations);
+    // Resolve composites once, now that every component is present
+    if (!relations.empty()) {
+        processCompositeRelations(relations);
     }
+}
+
+void FoodDatabase::rebuildIndexes() {
+    identifierIndex.clear();
+    keywordIndex.clear();
+    identifierIndex.reserve(positionSlots.size());
+    duplicateRows = 0;
     
-    return true;
+    // The first food in database order with a given identifier wins, as with a linear search
+    for (size_t slot : positionSlots) {
+        if (!identifierIndex.emplace(foodInSlot(slot).getIdentifier(), slot).second) {
+            ++duplicateRows;
+        }
+    }
+    
+    // Walking slots in ascending order keeps every posting list sorted
+    for (size_t slot = 0; slot < slotPositions.size(); ++slot) {
+        if (slotPositions[slot] == NO_POSITION) {
+            continue;
+        }
+        for (const auto& keyword : foodInSlot(slot).getKeywords()) {
+            auto& postings = keywordIndex[keyword];
+            if (postings.empty() || postings.back() != slot) {
+                postings.push_back(slot);
+            }
+        }
+    }
+}
+
+void FoodDatabase::rebuildSimilarityIndex() {
+    if (!similarityIndex) {
+        return;
+    }
+    similarityIndex->clear();
+    similarityIndex->reserve(positionSlots.size());
+    for (size_t slot : positionSlots) {
+        similarityIndex->addFood(foodInSlot(slot));
+    }
+}
+
+void FoodDatabase::indexKeywords(size_t slot) {
+    for (const auto& keyword : foodInSlot(slot).getKeywords()) {
+        auto& postings = keywordIndex[keyword];
+        auto insertAt = std::lower_bound(postings.begin(), postings.end(), slot);
+        if (insertAt == postings.end() || *insertAt != slot) {
+            postings.insert(insertAt, slot);
+        }
+    }
+}
+
+void FoodDatabase::unindexKeywords(size_t slot) {
+    for (const auto& keyword : foodInSlot(slot).getKeywords()) {
+        auto found = keywordIndex.find(keyword);
+        if (found == keywordIndex.end()) {
+            continue;
+        }
+        auto& postings = found->second;
+        auto eraseAt = std::lower_bound(postings.begin(), postings.end(), slot);
+        if (eraseAt != postings.end() && *eraseAt == slot) {
+            postings.erase(eraseAt);
+        }
+        if (postings.empty()) {
+            keywordIndex.erase(found);
+        }
+    }
 }
 
 void FoodDatabase::processCompositeRelations(const std::vector<CompositeRelation>& relations) {
     for (const auto& relation : relations) {
         // Find the composite food
-        Food* compositeFood = findFoodByIdentifier(relation.foodId);
-        if (!compositeFood) {
+        if (!getFood(relation.foodId)) {
             continue;
         }
         
@@ -80,7 +298,7 @@ void FoodDatabase::processCompositeRelations(const std::vector<CompositeRelation
         bool allComponentsFound = true;
         
         for (const auto& compId : relation.componentIds) {
-            Food* component = findFoodByIdentifier(compId);
+            const Food* component = getFood(compId);
             if (component) {
                 components.push_back(*component);
             } else {
@@ -92,36 +310,167 @@ void FoodDatabase::processCompositeRelations(const std::vector<CompositeRelation
         }
         
         if (allComponentsFound && !components.empty()) {
-            // Rebuild the composite food
-            Food newCompositeFood(relation.foodId, components);
-            // Replace the existing entry
-            *compositeFood = newCompositeFood;
+            // Rebuild the composite food and replace the existing entry,
+            // keeping the keyword index in step with the merged keywords
+            addFood(Food(relation.foodId, components));
         }
     }
 }
 
 bool FoodDatabase::saveToFile() const {
-    std::ofstream file(databaseFilename);
+    // Let a background save finish first so it cannot overwrite this one
+    waitForPendingSave();
+    return writeFoodsToFile(takeSnapshot(), databaseFilename);
+}
+
+std::shared_future<bool> FoodDatabase::saveToFileAsync() {
+    // Sharing the chunks is the snapshot; writes made while the save runs copy the chunk they touch.
+    // Only the chunk pointers and the order (one size_t per food) are copied here
+    FoodSnapshot snapshot = takeSnapshot();
+    chunkShared.assign(chunks.size(), true);
+    std::shared_future<bool> previousSave = pendingSave;
+    std::string filename = databaseFilename;
+    
+    pendingSave = std::async(std::launch::async, [snapshot, previousSave, filename]() mutable {
+        // The async state keeps this closure alive as long as any future refers to it,
+        // so release the snapshot and the previous save before reporting completion
+        std::shared_future<bool> previous = std::move(previousSave);
+        if (previous.valid()) {
+            previous.wait();
+        }
+        previous = std::shared_future<bool>();
+        
+        FoodSnapshot saved = std::move(snapshot);
+        bool written = writeFoodsToFile(saved, filename);
+        saved = FoodSnapshot();
+        return written;
+    }).share();
+    
+    return pendingSave;
+}
+
+void FoodDatabase::waitForPendingSave() const {
+    if (pendingSave.valid()) {
+        pendingSave.wait();
+    }
+}
+
+bool FoodDatabase::saveInFlight() const {
+    // Saves are chained, so the latest one finishing means all of them have
+    return pendingSave.valid() &&
+           pendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+FoodDatabase::FoodSnapshot FoodDatabase::takeSnapshot() const {
+    FoodSnapshot snapshot;
+    snapshot.chunks.assign(chunks.begin(), chunks.end());
+    snapshot.order = positionSlots;
+    return snapshot;
+}
+
+// Chunked storage
+const Food& FoodDatabase::foodInSlot(size_t slot) const {
+    return (*chunks[slot / FOODS_PER_CHUNK])[slot % FOODS_PER_CHUNK];
+}
+
+Food& FoodDatabase::writableFood(size_t slot) {
+    detachChunk(slot / FOODS_PER_CHUNK);
+    return (*chunks[slot / FOODS_PER_CHUNK])[slot % FOODS_PER_CHUNK];
+}
+
+void FoodDatabase::detachChunk(size_t chunk) {
+    if (!chunkShared[chunk]) {
+        return;
+    }
+    
+    // A running save still reads the chunk, so give the foreground its own copy;
+    // a finished save has already released it and the chunk can be written in place
+    if (saveInFlight()) {
+        auto copy = std::make_shared<FoodChunk>();
+        copy->reserve(FOODS_PER_CHUNK);
+        copy->assign(chunks[chunk]->begin(), chunks[chunk]->end());
+        chunks[chunk] = copy;
+    }
+    chunkShared[chunk] = false;
+}
+
+// Stores a food at the end of the database order, reusing a free slot when there is one
+size_t FoodDatabase::appendFood(Food food) {
+    size_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        writableFood(slot) = std::move(food);
+    } else {
+        slot = slotPositions.size();
+        if (slot % FOODS_PER_CHUNK == 0) {
+            // Full-size chunks never reallocate, so pointers into them stay valid
+            chunks.push_back(std::make_shared<FoodChunk>());
+            chunks.back()->reserve(FOODS_PER_CHUNK);
+            chunkShared.push_back(false);
+        }
+        detachChunk(chunks.size() - 1);
+        chunks.back()->push_back(std::move(food));
+        slotPositions.push_back(NO_POSITION);
+    }
+    
+    slotPositions[slot] = positionSlots.size();
+    positionSlots.push_back(slot);
+    return slot;
+}
+
+// Replaces the whole catalog with fresh chunks, so a background save keeps its snapshot
+void FoodDatabase::replaceFoods(std::vector<Food> loaded) {
+    chunks.clear();
+    chunkShared.clear();
+    positionSlots.clear();
+    slotPositions.clear();
+    freeSlots.clear();
+    
+    positionSlots.reserve(loaded.size());
+    slotPositions.reserve(loaded.size());
+    for (auto& food : loaded) {
+        appendFood(std::move(food));
+    }
+}
+
+// Writes to a temporary file and renames it over the database, so readers
+// never see a half-written file
+bool FoodDatabase::writeFoodsToFile(const FoodSnapshot& snapshot, const std::string& filename) {
+    std::string tempFilename = filename + ".tmp";
+    std::ofstream file(tempFilename);
     if (!file.is_open()) {
-        std::cerr << "Error: Could not open database file '" << databaseFilename << "' for writing." << std::endl;
+        std::cerr << "Error: Could not open database file '" << tempFilename << "' for writing." << std::endl;
         return false;
     }
     
     // Add a header comment
     file << "# Food Database Format: identifier;keyword1,keyword2,...;calories;isComposite;componentId1,componentId2,..." << std::endl;
     
-    for (const auto& food : foods) {
-        file << food.toString() << std::endl;
+    for (size_t slot : snapshot.order) {
+        file << (*snapshot.chunks[slot / FOODS_PER_CHUNK])[slot % FOODS_PER_CHUNK].toString() << '\n';
     }
     
     file.close();
+    if (file.fail()) {
+        std::cerr << "Error: Could not write database file '" << tempFilename << "'." << std::endl;
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+    
+    if (std::rename(tempFilename.c_str(), filename.c_str()) != 0) {
+        std::cerr << "Error: Could not replace database file '" << filename << "'." << std::endl;
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+    
     return true;
 }
 
 // Composite food operations
 bool FoodDatabase::createCompositeFood(const std::string& name, const std::vector<std::string>& componentIds) {
     // Check if food with this name already exists
-    if (findFoodByIdentifier(name) != nullptr) {
+    if (getFood(name) != nullptr) {
         std::cerr << "Error: Food with name '" << name << "' already exists." << std::endl;
         return false;
     }
@@ -129,7 +478,7 @@ bool FoodDatabase::createCompositeFood(const std::string& name, const std::vecto
     // Find all component foods
     std::vector<Food> components;
     for (const auto& compId : componentIds) {
-        Food* component = findFoodByIdentifier(compId);
+        const Food* component = getFood(compId);
         if (component) {
             components.push_back(*component);
         } else {
@@ -153,72 +502,211 @@ bool FoodDatabase::createCompositeFood(const std::string& name, const std::vecto
 // Food operations
 void FoodDatabase::addFood(const Food& food) {
     // Check if food with same identifier already exists
-    for (auto& existingFood : foods) {
-        if (existingFood.getIdentifier() == food.getIdentifier()) {
-            // Replace existing food
-            existingFood = food;
-            return;
-        }
+    auto existing = identifierIndex.find(food.getIdentifier());
+    if (existing != identifierIndex.end()) {
+        // Replace existing food
+        size_t slot = existing->second;
+        unindexKeywords(slot);
+        writableFood(slot) = food;
+        indexKeywords(slot);
+    } else {
+        // Add new food
+        size_t slot = appendFood(food);
+        identifierIndex.emplace(food.getIdentifier(), slot);
+        indexKeywords(slot);
     }
     
-    // Add new food
-    foods.push_back(food);
+    if (similarityIndex) {
+        similarityIndex->addFood(food);
+    }
+}
+
+void FoodDatabase::addFoods(const std::vector<Food>& newFoods) {
+    appendFoods(newFoods, std::vector<CompositeRelation>());
 }
 
 bool FoodDatabase::removeFood(const std::string& identifier) {
-    for (auto it = foods.begin(); it != foods.end(); ++it) {
-        if (it->getIdentifier() == identifier) {
-            foods.erase(it);
-            return true;
+    auto existing = identifierIndex.find(identifier);
+    if (existing == identifierIndex.end()) {
+        return false;
+    }
+    
+    if (similarityIndex) {
+        similarityIndex->removeFood(identifier);
+    }
+    
+    size_t slot = existing->second;
+    size_t position = slotPositions[slot];
+    
+    // A loaded file may repeat an identifier; the next such row takes over,
+    // as it would for a linear search
+    size_t nextSlot = NO_POSITION;
+    if (duplicateRows > 0) {
+        for (size_t later = position + 1; later < positionSlots.size(); ++later) {
+            if (foodInSlot(positionSlots[later]).getIdentifier() == identifier) {
+                nextSlot = positionSlots[later];
+                break;
+            }
+        }
+    }
+    
+    unindexKeywords(slot);
+    if (nextSlot != NO_POSITION) {
+        existing->second = nextSlot;
+        --duplicateRows;
+        if (similarityIndex) {
+            similarityIndex->addFood(foodInSlot(nextSlot));
         }
+    } else {
+        identifierIndex.erase(existing);
     }
-    return false;
+    writableFood(slot) = Food();
+    slotPositions[slot] = NO_POSITION;
+    freeSlots.push_back(slot);
+    
+    // The indexes refer to slots, so only the foods after this one need renumbering
+    positionSlots.erase(positionSlots.begin() + position);
+    for (size_t later = position; later < positionSlots.size(); ++later) {
+        slotPositions[positionSlots[later]] = later;
+    }
+    return true;
 }
 
 Food* FoodDatabase::findFoodByIdentifier(const std::string& identifier) {
-    for (auto& food : foods) {
-        if (food.getIdentifier() == identifier) {
-            return &food;
-        }
+    auto existing = identifierIndex.find(identifier);
+    if (existing == identifierIndex.end()) {
+        return nullptr;
     }
-    return nullptr;
+    
+    // The caller may modify the returned food, so it must not point into a snapshot
+    return &writableFood(existing->second);
 }
 
-std::vector<Food> FoodDatabase::findFoodsByKeyword(const std::string& keyword) const {
+const Food* FoodDatabase::getFood(const std::string& identifier) const {
+    auto existing = identifierIndex.find(identifier);
+    if (existing == identifierIndex.end()) {
+        return nullptr;
+    }
+    return &foodInSlot(existing->second);
+}
+
+std::vector<Food> FoodDatabase::foodsAt(const std::vector<size_t>& slots) const {
+    // Slots are reused after removals, so sort by position to return foods in database order
+    std::vector<size_t> positions;
+    positions.reserve(slots.size());
+    for (size_t slot : slots) {
+        positions.push_back(slotPositions[slot]);
+    }
+    std::sort(positions.begin(), positions.end());
+    
     std::vector<Food> result;
-    for (const auto& food : foods) {
-        if (food.matchKeyword(keyword)) {
-            result.push_back(food);
-        }
+    result.reserve(positions.size());
+    for (size_t position : positions) {
+        result.push_back(getFoodAt(position));
     }
     return result;
 }
 
+std::vector<Food> FoodDatabase::findFoodsByKeyword(const std::string& keyword) const {
+    auto found = keywordIndex.find(keyword);
+    if (found == keywordIndex.end()) {
+        return std::vector<Food>();
+    }
+    return foodsAt(found->second);
+}
+
 std::vector<Food> FoodDatabase::findFoodsByAllKeywords(const std::vector<std::string>& keywords) const {
-    std::vector<Food> result;
-    for (const auto& food : foods) {
-        if (food.matchAllKeywords(keywords)) {
-            result.push_back(food);
+    // No keywords matches every food, as with Food::matchAllKeywords
+    if (keywords.empty()) {
+        return getAllFoods();
+    }
+    
+    // Intersect the sorted posting lists
+    std::vector<size_t> matches;
+    for (size_t i = 0; i < keywords.size(); ++i) {
+        auto found = keywordIndex.find(keywords[i]);
+        if (found == keywordIndex.end()) {
+            return std::vector<Food>();
+        }
+        if (i == 0) {
+            matches = found->second;
+        } else {
+            std::vector<size_t> narrowed;
+            std::set_intersection(matches.begin(), matches.end(),
+                                  found->second.begin(), found->second.end(),
+                                  std::back_inserter(narrowed));
+            matches.swap(narrowed);
         }
     }
-    return result;
+    return foodsAt(matches);
 }
 
 std::vector<Food> FoodDatabase::findFoodsByAnyKeyword(const std::vector<std::string>& keywords) const {
+    // No keywords matches every food, as with Food::matchAnyKeyword
+    if (keywords.empty()) {
+        return getAllFoods();
+    }
+    
+    // Union of the sorted posting lists
+    std::vector<size_t> matches;
+    for (const auto& keyword : keywords) {
+        auto found = keywordIndex.find(keyword);
+        if (found == keywordIndex.end()) {
+            continue;
+        }
+        std::vector<size_t> merged;
+        std::set_union(matches.begin(), matches.end(),
+                       found->second.begin(), found->second.end(),
+                       std::back_inserter(merged));
+        matches.swap(merged);
+    }
+    return foodsAt(matches);
+}
+
+// Similarity operations
+void FoodDatabase::enableSimilarityIndex(size_t bandCount, size_t rowsPerBand) {
+    similarityIndex.reset(new FoodSimilarityIndex(bandCount, rowsPerBand));
+    rebuildSimilarityIndex();
+}
+
+const FoodSimilarityIndex* FoodDatabase::getSimilarityIndex() const {
+    return similarityIndex.get();
+}
+
+std::vector<Food> FoodDatabase::findSimilarFoods(const std::string& identifier, size_t k) const {
     std::vector<Food> result;
-    for (const auto& food : foods) {
-        if (food.matchAnyKeyword(keywords)) {
-            result.push_back(food);
+    if (!similarityIndex) {
+        std::cerr << "Error: Similarity index is not enabled." << std::endl;
+        return result;
+    }
+    
+    for (const auto& match : similarityIndex->findSimilar(identifier, k)) {
+        auto found = identifierIndex.find(match.identifier);
+        if (found != identifierIndex.end()) {
+            result.push_back(foodInSlot(found->second));
         }
     }
     return result;
 }
 
 // Other operations
+const std::string& FoodDatabase::getFilename() const {
+    return databaseFilename;
+}
+
 size_t FoodDatabase::size() const {
-    return foods.size();
+    return positionSlots.size();
+}
+
+const Food& FoodDatabase::getFoodAt(size_t position) const {
+    return foodInSlot(positionSlots[position]);
 }
 
-const std::vector<Food>& FoodDatabase::getAllFoods() const {
-    return foods;
+std::vector<Food> FoodDatabase::getAllFoods() const {
+    std::vector<Food> result;
+    result.reserve(positionSlots.size());
+    for (size_t slot : positionSlots) {
+        result.push_back(foodInSlot(slot));
+    }
+    return result;
 }
\ No newline at end of file
@@ -2,36 +2,125 @@
 #define FOOD_DATABASE_H
 
 #include "food.h"
+#include "food_similarity_index.h"
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
+#include <future>
+#include <chrono>
+#include <istream>
+#include <unordered_map>
+
+// Layouts understood by the importer
+enum class FoodFileFormat {
+    Auto,       // Detected from the first data line
+    Semicolon,  // identifier;keyword1,keyword2,...;calories;isComposite;componentId1,...
+    Pipe        // identifier|keyword1,keyword2,...|calories
+};
 
 class FoodDatabase {
 private:
-    std::vector<Food> foods;
+    // Foods live in fixed-size chunks addressed by slot (slot / chunk size, slot % chunk size).
+    // Chunks are shared with in-flight background saves and copied one at a time before
+    // their first write (copy-on-write), so a write during a save copies one chunk, not the catalog
+    typedef std::vector<Food> FoodChunk;
+    std::vector<std::shared_ptr<FoodChunk>> chunks;
+    // True from saveToFileAsync until the first write to that chunk has copied or reclaimed it
+    std::vector<bool> chunkShared;
     std::string databaseFilename;
+    // Most recent background save, chained so saves reach the file in request order
+    std::shared_future<bool> pendingSave;
+    
+    // Database order and lookup indexes. Each food keeps its slot for life and the indexes
+    // store slots, so a removal only renumbers positions; keyword postings are kept in ascending slot order
+    std::vector<size_t> positionSlots;  // position -> slot
+    std::vector<size_t> slotPositions;  // slot -> position
+    std::vector<size_t> freeSlots;
+    std::unordered_map<std::string, size_t> identifierIndex;
+    std::unordered_map<std::string, std::vector<size_t>> keywordIndex;
+    // Rows that repeat an earlier row's identifier (only loaded files contain them); such a row
+    // is reachable by identifier once the earlier one is removed
+    size_t duplicateRows;
+    // Optional MinHash/LSH index, kept in step with addFood and removeFood once enabled
+    std::unique_ptr<FoodSimilarityIndex> similarityIndex;
     
+public:
     // Helper structure for loading composite foods
     struct CompositeRelation {
         std::string foodId;
         std::vector<std::string> componentIds;
     };
     
+private:
     // Helper methods for composite foods
     void processCompositeRelations(const std::vector<CompositeRelation>& relations);
     
+    // What a save writes: the chunks plus the slot of every food in database order
+    struct FoodSnapshot {
+        std::vector<std::shared_ptr<const FoodChunk>> chunks;
+        std::vector<size_t> order;
+    };
+    
+    // Helper methods for chunked storage and copy-on-write snapshots
+    const Food& foodInSlot(size_t slot) const;
+    Food& writableFood(size_t slot);
+    void detachChunk(size_t chunk);
+    size_t appendFood(Food food);
+    void replaceFoods(std::vector<Food> loaded);
+    FoodSnapshot takeSnapshot() const;
+    bool saveInFlight() const;
+    static bool writeFoodsToFile(const FoodSnapshot& snapshot, const std::string& filename);
+    
+    // Helper methods for indexing and bulk import
+    void rebuildIndexes();
+    void rebuildSimilarityIndex();
+    void indexKeywords(size_t slot);
+    void unindexKeywords(size_t slot);
+    std::vector<Food> foodsAt(const std::vector<size_t>& slots) const;
+    void appendFoods(std::vector<Food> batch, const std::vector<CompositeRelation>& relations);
+    // Returns the number of malformed rows that were skipped
+    static size_t parseFoodRows(std::istream& input, FoodFileFormat format,
+                                std::vector<Food>& rows, std::vector<CompositeRelation>& relations);
+    
 public:
-    // Constructor
-    FoodDatabase(const std::string& filename = "foods.txt");
+    // Constructor (autoLoad = false leaves the database empty until loadFromFile is called)
+    FoodDatabase(const std::string& filename = "foods.txt", bool autoLoad = true);
+    
+    // Copies are deep: the storage chunks and the similarity index are cloned, so a copy
+    // never shares writable state with the original
+    FoodDatabase(const FoodDatabase& other);
+    FoodDatabase& operator=(const FoodDatabase& other);
+    FoodDatabase(FoodDatabase&& other) = default;
+    FoodDatabase& operator=(FoodDatabase&& other) = default;
     
     // Database operations
     bool loadFromFile();
+    // Loads foods without resolving composites; unresolved relations are returned to the caller
+    bool loadFromFile(std::vector<CompositeRelation>& pendingRelations);
     bool saveToFile() const;
+    // Snapshots the foods and writes them on a background thread; the database stays usable meanwhile
+    std::shared_future<bool> saveToFileAsync();
+    void waitForPendingSave() const;
+    const std::string& getFilename() const;
+    
+    // Bulk import: rows are appended without per-row checks; duplicates are folded
+    // (last row wins), indexes rebuilt and composites resolved once at the end.
+    // Malformed rows are skipped with a warning; their count is stored in skippedRows if given
+    bool importFromFile(const std::string& filename, FoodFileFormat format = FoodFileFormat::Auto,
+                        size_t* skippedRows = nullptr);
+    size_t importFromStream(std::istream& input, FoodFileFormat format = FoodFileFormat::Auto,
+                            size_t* skippedRows = nullptr);
     
-    // Food operations
+    // Food operations (foods returned by findFoodByIdentifier must not be re-keyed in place;
+    // use addFood to replace them so the indexes stay current)
     void addFood(const Food& food);
+    void addFoods(const std::vector<Food>& newFoods);
     bool removeFood(const std::string& identifier);
     Food* findFoodByIdentifier(const std::string& identifier);
+    // Read-only lookup; unlike findFoodByIdentifier it never copies a chunk shared with a save,
+    // so use it for existence checks and reads
+    const Food* getFood(const std::string& identifier) const;
     std::vector<Food> findFoodsByKeyword(const std::string& keyword) const;
     std::vector<Food> findFoodsByAllKeywords(const std::vector<std::string>& keywords) const;
     std::vector<Food> findFoodsByAnyKeyword(const std::vector<std::string>& keywords) const;
@@ -39,9 +128,17 @@ public:
     // Composite food operations
     bool createCompositeFood(const std::string& name, const std::vector<std::string>& componentIds);
     
+    // Similarity operations ("foods like this one", ranked by keyword overlap)
+    void enableSimilarityIndex(size_t bandCount = 32, size_t rowsPerBand = 2);
+    const FoodSimilarityIndex* getSimilarityIndex() const;
+    std::vector<Food> findSimilarFoods(const std::string& identifier, size_t k) const;
+    
     // Other operations
     size_t size() const;
-    const std::vector<Food>& getAllFoods() const;
+    // Food at a position in database order (0 <= position < size())
+    const Food& getFoodAt(size_t position) const;
+    // Copies every food in database order; use size() and getFoodAt to walk the catalog without copying
+    std::vector<Food> getAllFoods() const;
 };
 
 #endif // FOOD_DATABASE_H
\ No newline at end of file
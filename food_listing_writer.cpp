@@ -0,0 +1,230 @@
+#include "food_listing_writer.h"
+#include <charconv>
+
+static bool needsCsvQuoting(const std::string& field) {
+    return field.find_first_of(",\"\r\n") != std::string::npos;
+}
+
+// Appends a ';'-separated list as one CSV field straight into the buffer,
+// quoting the whole field only when some item needs it. A ';' or '\' inside
+// an item is preceded by '\' so the item boundaries can be recovered
+template <typename Items, typename NameOf>
+static void appendCsvList(std::string& buffer, const Items& items, NameOf nameOf) {
+    bool quoted = false;
+    for (const auto& item : items) {
+        if (needsCsvQuoting(nameOf(item))) {
+            quoted = true;
+            break;
+        }
+    }
+    
+    if (quoted) {
+        buffer += '"';
+    }
+    bool first = true;
+    for (const auto& item : items) {
+        if (!first) {
+            buffer += ';';
+        }
+        first = false;
+        for (char c : nameOf(item)) {
+            if (c == ';' || c == '\\') {
+                buffer += '\\';
+            } else if (quoted && c == '"') {
+                buffer += '"';
+            }
+            buffer += c;
+        }
+    }
+    if (quoted) {
+        buffer += '"';
+    }
+}
+
+// Constructor
+FoodListingWriter::FoodListingWriter(std::ostream& out, ListingFormat format, size_t bufferBytes)
+    : out(out), format(format), flushThreshold(bufferBytes) {
+    // Leave headroom so a row that crosses the threshold does not reallocate
+    buffer.reserve(bufferBytes + 4096);
+}
+
+FoodListingWriter::~FoodListingWriter() {
+    flush();
+}
+
+bool FoodListingWriter::flush() {
+    if (!buffer.empty()) {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+void FoodListingWriter::appendNumber(int value) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+// Fields with separators, quotes or line breaks are quoted as in RFC 4180
+void FoodListingWriter::appendCsvField(const std::string& field) {
+    if (!needsCsvQuoting(field)) {
+        buffer += field;
+        return;
+    }
+    buffer += '"';
+    for (char c : field) {
+        if (c == '"') {
+            buffer += '"';
+        }
+        buffer += c;
+    }
+    buffer += '"';
+}
+
+void FoodListingWriter::appendJsonString(const std::string& value) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    buffer += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':  buffer += "\\\""; break;
+            case '\\': buffer += "\\\\"; break;
+            case '\n': buffer += "\\n"; break;
+            case '\r': buffer += "\\r"; break;
+            case '\t': buffer += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    buffer += "\\u00";
+                    buffer += HEX_DIGITS[(c >> 4) & 0xF];
+                    buffer += HEX_DIGITS[c & 0xF];
+                } else {
+                    buffer += c;
+                }
+        }
+    }
+    buffer += '"';
+}
+
+void FoodListingWriter::appendTableRow(const Food& food) {
+    buffer += food.getIdentifier();
+    buffer += '\t';
+    appendNumber(food.getCaloriesPerServing());
+    buffer += "\t\t";
+    buffer += food.getIsComposite() ? "Composite\t" : "Basic\t\t";
+    
+    const auto& keywords = food.getKeywords();
+    for (size_t i = 0; i < keywords.size(); ++i) {
+        buffer += keywords[i];
+        if (i < keywords.size() - 1) {
+            buffer += ", ";
+        }
+    }
+    buffer += '\n';
+    
+    // If it's a composite food, list its components
+    if (food.getIsComposite()) {
+        buffer += "  Components: ";
+        const auto& components = food.getComponents();
+        for (size_t i = 0; i < components.size(); ++i) {
+            buffer += components[i].getIdentifier();
+            if (i < components.size() - 1) {
+                buffer += ", ";
+            }
+        }
+        buffer += '\n';
+    }
+}
+
+void FoodListingWriter::appendCsvRow(const Food& food) {
+    appendCsvField(food.getIdentifier());
+    buffer += ',';
+    appendNumber(food.getCaloriesPerServing());
+    buffer += food.getIsComposite() ? ",composite," : ",basic,";
+    appendCsvList(buffer, food.getKeywords(), [](const std::string& keyword) -> const std::string& {
+        return keyword;
+    });
+    buffer += ',';
+    appendCsvList(buffer, food.getComponents(), [](const Food& component) -> const std::string& {
+        return component.getIdentifier();
+    });
+    buffer += '\n';
+}
+
+void FoodListingWriter::appendJsonRow(const Food& food) {
+    buffer += "{\"identifier\":";
+    appendJsonString(food.getIdentifier());
+    buffer += ",\"calories\":";
+    appendNumber(food.getCaloriesPerServing());
+    buffer += food.getIsComposite() ? ",\"composite\":true" : ",\"composite\":false";
+    
+    buffer += ",\"keywords\":[";
+    const auto& keywords = food.getKeywords();
+    for (size_t i = 0; i < keywords.size(); ++i) {
+        if (i > 0) {
+            buffer += ',';
+        }
+        appendJsonString(keywords[i]);
+    }
+    
+    buffer += "],\"components\":[";
+    const auto& components = food.getComponents();
+    for (size_t i = 0; i < components.size(); ++i) {
+        if (i > 0) {
+            buffer += ',';
+        }
+        appendJsonString(components[i].getIdentifier());
+    }
+    buffer += "]}\n";
+}
+
+// Listing operations
+void FoodListingWriter::writeHeader() {
+    switch (format) {
+        case ListingFormat::Table:
+            buffer += "ID\tCalories\tType\t\tKeywords\n";
+            buffer += "-------------------------------------------------------\n";
+            break;
+        case ListingFormat::Csv:
+            buffer += "identifier,calories,type,keywords,components\n";
+            break;
+        case ListingFormat::JsonLines:
+            // JSON Lines has no header
+            break;
+    }
+}
+
+void FoodListingWriter::writeFood(const Food& food) {
+    switch (format) {
+        case ListingFormat::Table:
+            appendTableRow(food);
+            break;
+        case ListingFormat::Csv:
+            appendCsvRow(food);
+            break;
+        case ListingFormat::JsonLines:
+            appendJsonRow(food);
+            break;
+    }
+    
+    if (buffer.size() >= flushThreshold) {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
+
+size_t FoodListingWriter::writeFoods(const std::vector<Food>& foods, size_t offset, size_t limit) {
+    if (offset >= foods.size()) {
+        return 0;
+    }
+    
+    size_t end = foods.size();
+    if (limit < end - offset) {
+        end = offset + limit;
+    }
+    
+    for (size_t i = offset; i < end; ++i) {
+        writeFood(foods[i]);
+    }
+    return end - offset;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef FOOD_LISTING_WRITER_H
+#define FOOD_LISTING_WRITER_H
+
+#include "food.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Output layouts for food listings
+enum class ListingFormat {
+    Table,      // The tab-separated listing shown in the menu
+    Csv,        // identifier,calories,type,keywords,components with RFC 4180 quoting; the list
+                // fields separate items with ';' and write a ';' or '\' inside an item as "\;" or "\\"
+    JsonLines   // One JSON object per food
+};
+
+// Formats foods into one large reusable buffer and hands it to the stream in big writes,
+// so dumping a whole catalog costs a few write calls instead of several per food.
+class FoodListingWriter {
+private:
+    std::ostream& out;
+    ListingFormat format;
+    std::string buffer;
+    size_t flushThreshold;
+    
+    // Helper methods
+    void appendNumber(int value);
+    void appendCsvField(const std::string& field);
+    void appendJsonString(const std::string& value);
+    void appendTableRow(const Food& food);
+    void appendCsvRow(const Food& food);
+    void appendJsonRow(const Food& food);
+    
+public:
+    // Constructor (bufferBytes is how much is formatted before each write)
+    FoodListingWriter(std::ostream& out, ListingFormat format, size_t bufferBytes = 1 << 20);
+    ~FoodListingWriter();
+    
+    // The writer holds a reference to its stream, so it cannot be copied
+    FoodListingWriter(const FoodListingWriter&) = delete;
+    FoodListingWriter& operator=(const FoodListingWriter&) = delete;
+    
+    // Listing operations
+    void writeHeader();
+    void writeFood(const Food& food);
+    // Writes one page: at most limit foods starting at offset; returns how many were written
+    size_t writeFoods(const std::vector<Food>& foods, size_t offset = 0, size_t limit = static_cast<size_t>(-1));
+    bool flush();
+};
+
+#endif // FOOD_LISTING_WRITER_H
\ No newline at end of file
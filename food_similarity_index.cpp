@@ -0,0 +1,219 @@
+#include "food_similarity_index.h"
+#include "stable_hash.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+// splitmix64 finaliser: cheap and well mixed, used to derive every MinHash function
+static uint64_t mixHash(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+static std::vector<std::string> normalizeKeywords(const std::vector<std::string>& keywords) {
+    std::vector<std::string> result(keywords);
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+// Both inputs must be sorted and unique
+static double jaccardSimilarity(const std::vector<std::string>& a, const std::vector<std::string>& b) {
+    if (a.empty() && b.empty()) {
+        return 0.0;
+    }
+    size_t shared = 0;
+    auto left = a.begin();
+    auto right = b.begin();
+    while (left != a.end() && right != b.end()) {
+        if (*left < *right) {
+            ++left;
+        } else if (*right < *left) {
+            ++right;
+        } else {
+            ++shared;
+            ++left;
+            ++right;
+        }
+    }
+    return static_cast<double>(shared) / static_cast<double>(a.size() + b.size() - shared);
+}
+
+// Constructor
+FoodSimilarityIndex::FoodSimilarityIndex(size_t bandCount, size_t rowsPerBand)
+    : bandCount(std::max<size_t>(bandCount, 1)), rowsPerBand(std::max<size_t>(rowsPerBand, 1)) {
+    hashSeeds.resize(this->bandCount * this->rowsPerBand);
+    for (size_t i = 0; i < hashSeeds.size(); ++i) {
+        hashSeeds[i] = mixHash(i + 1);
+    }
+    bandBuckets.resize(this->bandCount);
+}
+
+std::vector<uint64_t> FoodSimilarityIndex::computeSignature(const std::vector<std::string>& keywords) const {
+    std::vector<uint64_t> signature(hashSeeds.size(), std::numeric_limits<uint64_t>::max());
+    for (const auto& keyword : keywords) {
+        uint64_t base = stableHash(keyword);
+        for (size_t i = 0; i < hashSeeds.size(); ++i) {
+            signature[i] = std::min(signature[i], mixHash(base ^ hashSeeds[i]));
+        }
+    }
+    return signature;
+}
+
+uint64_t FoodSimilarityIndex::bandKey(const std::vector<uint64_t>& signature, size_t band) const {
+    uint64_t key = band;
+    for (size_t row = 0; row < rowsPerBand; ++row) {
+        key = mixHash(key ^ signature[band * rowsPerBand + row]);
+    }
+    return key;
+}
+
+// Index maintenance
+void FoodSimilarityIndex::addFood(const Food& food) {
+    std::string identifier = food.getIdentifier();
+    removeFood(identifier);
+    
+    std::vector<std::string> keywords = normalizeKeywords(food.getKeywords());
+    
+    // A food without keywords has nothing to be similar on
+    if (keywords.empty()) {
+        return;
+    }
+    
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(entries.size());
+        entries.emplace_back();
+    }
+    
+    Entry& entry = entries[slot];
+    entry.identifier = identifier;
+    entry.keywords = std::move(keywords);
+    entry.signature = computeSignature(entry.keywords);
+    for (size_t band = 0; band < bandCount; ++band) {
+        bandBuckets[band][bandKey(entry.signature, band)].push_back(slot);
+    }
+    slotByIdentifier.emplace(identifier, slot);
+}
+
+bool FoodSimilarityIndex::removeFood(const std::string& identifier) {
+    auto found = slotByIdentifier.find(identifier);
+    if (found == slotByIdentifier.end()) {
+        return false;
+    }
+    
+    uint32_t slot = found->second;
+    Entry& entry = entries[slot];
+    for (size_t band = 0; band < bandCount; ++band) {
+        auto bucket = bandBuckets[band].find(bandKey(entry.signature, band));
+        if (bucket == bandBuckets[band].end()) {
+            continue;
+        }
+        auto& members = bucket->second;
+        members.erase(std::remove(members.begin(), members.end(), slot), members.end());
+        if (members.empty()) {
+            bandBuckets[band].erase(bucket);
+        }
+    }
+    
+    entry = Entry();
+    freeSlots.push_back(slot);
+    slotByIdentifier.erase(found);
+    return true;
+}
+
+void FoodSimilarityIndex::clear() {
+    entries.clear();
+    freeSlots.clear();
+    slotByIdentifier.clear();
+    for (auto& buckets : bandBuckets) {
+        buckets.clear();
+    }
+}
+
+void FoodSimilarityIndex::reserve(size_t foodCount) {
+    entries.reserve(foodCount);
+    slotByIdentifier.reserve(foodCount);
+    for (auto& buckets : bandBuckets) {
+        buckets.reserve(foodCount);
+    }
+}
+
+// Queries
+std::vector<SimilarityMatch> FoodSimilarityIndex::rankCandidates(const std::vector<std::string>& keywords,
+                                                                 const std::vector<uint64_t>& signature,
+                                                                 const std::string& excludeIdentifier, size_t k) const {
+    // Gather everything sharing at least one band bucket
+    std::vector<uint32_t> candidates;
+    for (size_t band = 0; band < bandCount; ++band) {
+        auto bucket = bandBuckets[band].find(bandKey(signature, band));
+        if (bucket != bandBuckets[band].end()) {
+            candidates.insert(candidates.end(), bucket->second.begin(), bucket->second.end());
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    
+    // Exact rerank removes the false positives LSH lets through
+    std::vector<SimilarityMatch> matches;
+    matches.reserve(candidates.size());
+    for (uint32_t slot : candidates) {
+        const Entry& entry = entries[slot];
+        if (entry.identifier == excludeIdentifier) {
+            continue;
+        }
+        double similarity = jaccardSimilarity(keywords, entry.keywords);
+        if (similarity > 0.0) {
+            matches.push_back({entry.identifier, similarity});
+        }
+    }
+    
+    auto byScore = [](const SimilarityMatch& a, const SimilarityMatch& b) {
+        if (a.similarity != b.similarity) {
+            return a.similarity > b.similarity;
+        }
+        return a.identifier < b.identifier;
+    };
+    if (matches.size() > k) {
+        std::partial_sort(matches.begin(), matches.begin() + k, matches.end(), byScore);
+        matches.resize(k);
+    } else {
+        std::sort(matches.begin(), matches.end(), byScore);
+    }
+    return matches;
+}
+
+std::vector<SimilarityMatch> FoodSimilarityIndex::findSimilar(const std::string& identifier, size_t k) const {
+    auto found = slotByIdentifier.find(identifier);
+    if (found == slotByIdentifier.end() || k == 0) {
+        return std::vector<SimilarityMatch>();
+    }
+    const Entry& entry = entries[found->second];
+    return rankCandidates(entry.keywords, entry.signature, identifier, k);
+}
+
+std::vector<SimilarityMatch> FoodSimilarityIndex::findSimilarToKeywords(const std::vector<std::string>& keywords, size_t k) const {
+    std::vector<std::string> normalized = normalizeKeywords(keywords);
+    if (normalized.empty() || k == 0) {
+        return std::vector<SimilarityMatch>();
+    }
+    return rankCandidates(normalized, computeSignature(normalized), std::string(), k);
+}
+
+// Other operations
+size_t FoodSimilarityIndex::size() const {
+    return slotByIdentifier.size();
+}
+
+size_t FoodSimilarityIndex::getBandCount() const {
+    return bandCount;
+}
+
+size_t FoodSimilarityIndex::getRowsPerBand() const {
+    return rowsPerBand;
+}
\ No newline at end of file
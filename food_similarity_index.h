@@ -0,0 +1,68 @@
+#ifndef FOOD_SIMILARITY_INDEX_H
+#define FOOD_SIMILARITY_INDEX_H
+
+#include "food.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A neighbour returned by a similarity query
+struct SimilarityMatch {
+    std::string identifier;
+    double similarity;   // Exact Jaccard similarity of the keyword sets
+};
+
+// Approximate nearest-neighbour index over food keyword sets.
+// Each food gets a MinHash signature of bandCount * rowsPerBand values; the signature is
+// split into bands and foods sharing any band land in the same bucket. Only bucket
+// neighbours are compared exactly. Two foods with similarity s become candidates with
+// probability 1 - (1 - s^rowsPerBand)^bandCount: more bands raise recall, more rows per
+// band make buckets smaller and queries faster.
+class FoodSimilarityIndex {
+private:
+    struct Entry {
+        std::string identifier;
+        std::vector<uint64_t> signature;
+        std::vector<std::string> keywords;   // Sorted and unique, for the exact rerank
+    };
+    
+    size_t bandCount;
+    size_t rowsPerBand;
+    std::vector<uint64_t> hashSeeds;
+    
+    // Entries live in slots so buckets can hold small integers; removed slots are reused
+    std::vector<Entry> entries;
+    std::vector<uint32_t> freeSlots;
+    std::unordered_map<std::string, uint32_t> slotByIdentifier;
+    std::vector<std::unordered_map<uint64_t, std::vector<uint32_t>>> bandBuckets;
+    
+    // Helper methods
+    std::vector<uint64_t> computeSignature(const std::vector<std::string>& keywords) const;
+    uint64_t bandKey(const std::vector<uint64_t>& signature, size_t band) const;
+    std::vector<SimilarityMatch> rankCandidates(const std::vector<std::string>& keywords,
+                                                const std::vector<uint64_t>& signature,
+                                                const std::string& excludeIdentifier, size_t k) const;
+    
+public:
+    // Constructor (the defaults suit foods with a handful of keywords each)
+    FoodSimilarityIndex(size_t bandCount = 32, size_t rowsPerBand = 2);
+    
+    // Index maintenance (adding an existing identifier replaces it)
+    void addFood(const Food& food);
+    bool removeFood(const std::string& identifier);
+    void clear();
+    // Sizes the band tables for a bulk build of this many foods
+    void reserve(size_t foodCount);
+    
+    // Top-k queries, most similar first
+    std::vector<SimilarityMatch> findSimilar(const std::string& identifier, size_t k) const;
+    std::vector<SimilarityMatch> findSimilarToKeywords(const std::vector<std::string>& keywords, size_t k) const;
+    
+    // Other operations
+    size_t size() const;
+    size_t getBandCount() const;
+    size_t getRowsPerBand() const;
+};
+
+#endif // FOOD_SIMILARITY_INDEX_H
\ No newline at end of file
@@ -1,9 +1,13 @@
 #include "food.h"
 #include "food_database.h"
+#include "food_listing_writer.h"
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <vector>
 #include <limits>
+#include <future>
+#include <chrono>
 
 // Function to clear the input buffer
 void clearInputBuffer() {
@@ -64,41 +68,53 @@ void addNewFood(FoodDatabase& db) {
 void displayAllFoods(const FoodDatabase& db) {
     std::cout << "\n=== All Foods ===\n";
     
-    const auto& foods = db.getAllFoods();
-    if (foods.empty()) {
+    if (db.size() == 0) {
         std::cout << "No foods in the database.\n";
         return;
     }
     
-    std::cout << "ID\tCalories\tType\t\tKeywords\n";
-    std::cout << "-------------------------------------------------------\n";
+    // Render through one large buffer instead of many small insertions
+    FoodListingWriter writer(std::cout, ListingFormat::Table);
+    writer.writeHeader();
+    for (size_t position = 0; position < db.size(); ++position) {
+        writer.writeFood(db.getFoodAt(position));
+    }
+}
+
+// Function to export all foods to a file
+void exportFoods(const FoodDatabase& db) {
+    std::string formatChoice;
+    std::string filename;
     
-    for (const auto& food : foods) {
-        std::cout << food.getIdentifier() << "\t";
-        std::cout << food.getCaloriesPerServing() << "\t\t";
-        std::cout << (food.getIsComposite() ? "Composite\t" : "Basic\t\t");
-        
-        const auto& keywords = food.getKeywords();
-        for (size_t i = 0; i < keywords.size(); ++i) {
-            std::cout << keywords[i];
-            if (i < keywords.size() - 1) {
-                std::cout << ", ";
-            }
-        }
-        std::cout << "\n";
-        
-        // If it's a composite food, display its components
-        if (food.getIsComposite()) {
-            std::cout << "  Components: ";
-            const auto& components = food.getComponents();
-            for (size_t i = 0; i < components.size(); ++i) {
-                std::cout << components[i].getIdentifier();
-                if (i < components.size() - 1) {
-                    std::cout << ", ";
-                }
-            }
-            std::cout << "\n";
-        }
+    std::cout << "\n=== Export Foods ===\n";
+    std::cout << "Export as (C)SV or (J)SON Lines? (C/J): ";
+    std::getline(std::cin, formatChoice);
+    
+    ListingFormat format = ListingFormat::Csv;
+    if (formatChoice == "J" || formatChoice == "j") {
+        format = ListingFormat::JsonLines;
+    }
+    
+    std::cout << "Enter file name: ";
+    std::getline(std::cin, filename);
+    
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "Error: Could not open '" << filename << "' for writing.\n";
+        return;
+    }
+    
+    FoodListingWriter writer(file, format);
+    writer.writeHeader();
+    size_t written = 0;
+    for (size_t position = 0; position < db.size(); ++position) {
+        writer.writeFood(db.getFoodAt(position));
+        ++written;
+    }
+    if (writer.flush()) {
+        std::cout << "\nExported " << written << " foods to \"" << filename << "\".\n";
+    } else {
+        std::cout << "\nError writing '" << filename << "'.\n";
     }
 }
 
@@ -115,7 +131,7 @@ void createCompositeFood(FoodDatabase& db) {
     std::getline(std::cin, compositeName);
     
     // Check if food with this name already exists
-    if (db.findFoodByIdentifier(compositeName) != nullptr) {
+    if (db.getFood(compositeName) != nullptr) {
         std::cout << "Error: Food with name '" << compositeName << "' already exists.\n";
         return;
     }
@@ -129,7 +145,7 @@ void createCompositeFood(FoodDatabase& db) {
         std::getline(std::cin, componentId);
         
         // Check if the food exists
-        if (db.findFoodByIdentifier(componentId) == nullptr) {
+        if (db.getFood(componentId) == nullptr) {
             std::cout << "Food with ID \"" << componentId << "\" not found in database.\n";
         } else {
             componentIds.push_back(componentId);
@@ -150,7 +166,7 @@ void createCompositeFood(FoodDatabase& db) {
     if (db.createCompositeFood(compositeName, componentIds)) {
         std::cout << "\nComposite food \"" << compositeName << "\" created with components:\n";
         for (const auto& id : componentIds) {
-            const Food* comp = db.findFoodByIdentifier(id);
+            const Food* comp = db.getFood(id);
             if (comp) {
                 std::cout << "- " << comp->getIdentifier() << " (" << comp->getCaloriesPerServing() << " calories)\n";
             }
@@ -222,35 +238,9 @@ void searchFoodsByKeyword(const FoodDatabase& db) {
         return;
     }
     
-    std::cout << "ID\tCalories\tType\t\tKeywords\n";
-    std::cout << "-------------------------------------------------------\n";
-    
-    for (const auto& food : results) {
-        std::cout << food.getIdentifier() << "\t";
-        std::cout << food.getCaloriesPerServing() << "\t\t";
-        std::cout << (food.getIsComposite() ? "Composite\t" : "Basic\t\t");
-        
-        const auto& foodKeywords = food.getKeywords();
-        for (size_t i = 0; i < foodKeywords.size(); ++i) {
-            std::cout << foodKeywords[i];
-            if (i < foodKeywords.size() - 1) {
-                std::cout << ", ";
-            }
-        }
-        std::cout << "\n";
-        
-        if (food.getIsComposite()) {
-            std::cout << "  Components: ";
-            const auto& components = food.getComponents();
-            for (size_t i = 0; i < components.size(); ++i) {
-                std::cout << components[i].getIdentifier();
-                if (i < components.size() - 1) {
-                    std::cout << ", ";
-                }
-            }
-            std::cout << "\n";
-        }
-    }
+    FoodListingWriter writer(std::cout, ListingFormat::Table);
+    writer.writeHeader();
+    writer.writeFoods(results);
 }
 
 // Main menu function
@@ -262,7 +252,8 @@ void displayMenu() {
     std::cout << "4. Create composite food\n";
     std::cout << "5. Save database\n";
     std::cout << "6. Exit\n";
-    std::cout << "Enter your choice (1-6): ";
+    std::cout << "7. Export foods\n";
+    std::cout << "Enter your choice (1-7): ";
 }
 
 int main() {
@@ -274,8 +265,20 @@ int main() {
     
     int choice;
     bool exitProgram = false;
+    std::shared_future<bool> pendingSave;
     
     while (!exitProgram) {
+        // Report a finished background save without blocking the menu
+        if (pendingSave.valid() &&
+            pendingSave.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            if (pendingSave.get()) {
+                std::cout << "\nDatabase saved successfully!\n";
+            } else {
+                std::cout << "\nError saving database.\n";
+            }
+            pendingSave = std::shared_future<bool>();
+        }
+        
         displayMenu();
         
         if (!(std::cin >> choice)) {
@@ -299,11 +302,8 @@ int main() {
                 createCompositeFood(db);
                 break;
             case 5:
-                if (db.saveToFile()) {
-                    std::cout << "\nDatabase saved successfully!\n";
-                } else {
-                    std::cout << "\nError saving database.\n";
-                }
+                pendingSave = db.saveToFileAsync();
+                std::cout << "\nSaving database in the background...\n";
                 break;
             case 6:
                 std::cout << "\nSaving database before exit...\n";
@@ -311,6 +311,9 @@ int main() {
                 std::cout << "Thank you for using YADA. Goodbye!\n";
                 exitProgram = true;
                 break;
+            case 7:
+                exportFoods(db);
+                break;
             default:
                 std::cout << "Invalid choice. Please try again.\n";
         }
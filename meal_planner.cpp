@@ -0,0 +1,190 @@
+#include "meal_planner.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+// A plan as sorted positions into the food list, so equal plans compare equal
+typedef std::vector<size_t> PlanKey;
+
+// How often (in foods) a round checks the clock
+static const size_t DEADLINE_CHECK_INTERVAL = 64;
+
+// One subset-sum round over the foods in the given order.
+// A total keeps the first food that reached it, so every chain of back-pointers
+// uses each food at most once; plans landing in [low, high] are reported.
+static void runSearchRound(const FoodDatabase& database, const std::vector<size_t>& order,
+                           int low, int high, size_t maxItems, Clock::time_point deadline,
+                           std::map<PlanKey, int>& found) {
+    const int UNREACHED = -1;
+    std::vector<int> reachedBy(high + 1, UNREACHED);
+    std::vector<size_t> itemCount(high + 1, 0);
+    
+    for (size_t step = 0; step < order.size(); ++step) {
+        if (step % DEADLINE_CHECK_INTERVAL == 0 && Clock::now() >= deadline) {
+            break;
+        }
+        
+        int calories = database.getFoodAt(order[step]).getCaloriesPerServing();
+        // Walk totals downwards so this food is added at most once per round
+        for (int total = high; total >= calories; --total) {
+            if (reachedBy[total] != UNREACHED) {
+                continue;
+            }
+            int previous = total - calories;
+            if (previous != 0 && reachedBy[previous] == UNREACHED) {
+                continue;
+            }
+            size_t count = (previous == 0 ? 0 : itemCount[previous]) + 1;
+            if (maxItems != 0 && count > maxItems) {
+                continue;
+            }
+            reachedBy[total] = static_cast<int>(step);
+            itemCount[total] = count;
+        }
+    }
+    
+    for (int total = std::max(low, 1); total <= high; ++total) {
+        if (reachedBy[total] == UNREACHED) {
+            continue;
+        }
+        PlanKey key;
+        for (int remaining = total; remaining > 0; ) {
+            size_t position = order[reachedBy[remaining]];
+            key.push_back(position);
+            remaining -= database.getFoodAt(position).getCaloriesPerServing();
+        }
+        std::sort(key.begin(), key.end());
+        found.emplace(key, total);
+    }
+}
+
+// Constructor
+MealPlanner::MealPlanner(const FoodDatabase& database) : database(database) {}
+
+std::vector<size_t> MealPlanner::selectCandidates(const MealPlanRequest& request) const {
+    int high = request.targetCalories + request.tolerance;
+    
+    // Prune foods that can never be part of an acceptable plan
+    std::vector<size_t> candidates;
+    for (size_t position = 0; position < database.size(); ++position) {
+        const Food& food = database.getFoodAt(position);
+        int calories = food.getCaloriesPerServing();
+        if (calories <= 0 || calories > high) {
+            continue;
+        }
+        if (!request.allowedKeywords.empty() && !food.matchAnyKeyword(request.allowedKeywords)) {
+            continue;
+        }
+        if (!request.excludedKeywords.empty() && food.matchAnyKeyword(request.excludedKeywords)) {
+            continue;
+        }
+        candidates.push_back(position);
+    }
+    return candidates;
+}
+
+std::vector<MealPlan> MealPlanner::findMealPlans(const MealPlanRequest& request) const {
+    std::vector<MealPlan> plans;
+    if (request.maxPlans == 0 || request.targetCalories <= 0 || request.tolerance < 0) {
+        return plans;
+    }
+    if (static_cast<long long>(request.targetCalories) + request.tolerance > MAX_PLAN_CALORIES) {
+        std::cerr << "Error: Meal plan targets are limited to " << MAX_PLAN_CALORIES
+                  << " calories including tolerance." << std::endl;
+        return plans;
+    }
+    
+    std::vector<size_t> candidates = selectCandidates(request);
+    if (candidates.empty()) {
+        return plans;
+    }
+    
+    int low = request.targetCalories - request.tolerance;
+    int high = request.targetCalories + request.tolerance;
+    Clock::time_point deadline = Clock::now() + request.timeBudget;
+    
+    unsigned threadCount = request.threadCount;
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    // Enough rounds to give every thread work and to turn up k distinct plans
+    size_t roundCount = std::max<size_t>(threadCount, request.maxPlans * 2);
+    
+    std::vector<std::map<PlanKey, int>> workerResults(threadCount);
+    std::atomic<bool> outOfMemory(false);
+    std::vector<std::thread> workers;
+    for (unsigned worker = 0; worker < threadCount; ++worker) {
+        workers.emplace_back([&, worker]() {
+            // An exception escaping a thread would terminate the program, so stop this worker instead
+            try {
+                for (size_t round = worker; round < roundCount; round += threadCount) {
+                    if (Clock::now() >= deadline || outOfMemory) {
+                        break;
+                    }
+                    
+                    std::vector<size_t> order = candidates;
+                    if (round == 0) {
+                        // Highest calories first favours plans with few foods
+                        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+                            return database.getFoodAt(a).getCaloriesPerServing() >
+                                   database.getFoodAt(b).getCaloriesPerServing();
+                        });
+                    } else {
+                        std::mt19937 generator(static_cast<unsigned>(round));
+                        std::shuffle(order.begin(), order.end(), generator);
+                    }
+                    
+                    runSearchRound(database, order, low, high, request.maxItems, deadline, workerResults[worker]);
+                }
+            } catch (const std::bad_alloc&) {
+                outOfMemory = true;
+            }
+        });
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    
+    if (outOfMemory) {
+        std::cerr << "Warning: Meal plan search ran out of memory; results may be incomplete." << std::endl;
+    }
+    
+    // Merge and rank: distance from the target, then number of foods
+    std::map<PlanKey, int> merged;
+    for (const auto& result : workerResults) {
+        merged.insert(result.begin(), result.end());
+    }
+    
+    std::vector<std::pair<PlanKey, int>> ranked(merged.begin(), merged.end());
+    int target = request.targetCalories;
+    std::sort(ranked.begin(), ranked.end(), [target](const std::pair<PlanKey, int>& a, const std::pair<PlanKey, int>& b) {
+        int distanceA = std::abs(a.second - target);
+        int distanceB = std::abs(b.second - target);
+        if (distanceA != distanceB) {
+            return distanceA < distanceB;
+        }
+        if (a.first.size() != b.first.size()) {
+            return a.first.size() < b.first.size();
+        }
+        return a.first < b.first;
+    });
+    
+    for (size_t i = 0; i < ranked.size() && plans.size() < request.maxPlans; ++i) {
+        MealPlan plan;
+        plan.totalCalories = ranked[i].second;
+        for (size_t position : ranked[i].first) {
+            plan.foods.push_back(database.getFoodAt(position));
+        }
+        plans.push_back(plan);
+    }
+    
+    return plans;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef MEAL_PLANNER_H
+#define MEAL_PLANNER_H
+
+#include "food.h"
+#include "food_database.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+// What a meal plan has to satisfy
+struct MealPlanRequest {
+    int targetCalories = 2000;
+    int tolerance = 50;                          // Plans within target +/- tolerance are accepted
+    std::vector<std::string> allowedKeywords;    // Foods must match any of these (empty allows all)
+    std::vector<std::string> excludedKeywords;   // Foods matching any of these are never used
+    size_t maxPlans = 5;                         // Number of best plans to return
+    size_t maxItems = 0;                         // Most foods in one plan (0 means no limit)
+    std::chrono::milliseconds timeBudget{1000};  // Search stops when this runs out
+    unsigned threadCount = 0;                    // 0 uses every hardware thread
+};
+
+// A set of foods (one serving each) and its calorie total
+struct MealPlan {
+    std::vector<Food> foods;
+    int totalCalories;
+};
+
+// Finds combinations of foods whose calories hit a target.
+// Each search round is a bounded subset-sum dynamic program over calorie totals;
+// rounds use different food orders to reach different combinations and run on
+// several threads at once until the time budget is spent.
+class MealPlanner {
+private:
+    const FoodDatabase& database;
+    
+    // Helper methods
+    std::vector<size_t> selectCandidates(const MealPlanRequest& request) const;
+    
+public:
+    // Largest target + tolerance accepted; each search round holds one table entry per calorie
+    static const int MAX_PLAN_CALORIES = 100000;
+    
+    // Constructor
+    MealPlanner(const FoodDatabase& database);
+    
+    // Returns up to maxPlans distinct plans, closest to the target first
+    // (ties go to the plan with fewer foods); requests above MAX_PLAN_CALORIES return no plans
+    std::vector<MealPlan> findMealPlans(const MealPlanRequest& request) const;
+};
+
+#endif // MEAL_PLANNER_H
\ No newline at end of file
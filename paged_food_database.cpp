@@ -0,0 +1,354 @@
+#include "paged_food_database.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Guards composite resolution against cyclic component references
+static const int MAX_COMPOSITE_DEPTH = 32;
+
+// Rough heap footprint of a decoded food, used to charge the cache budget
+static size_t approximateFoodSize(const Food& food) {
+    size_t bytes = sizeof(Food) + food.getIdentifier().capacity();
+    for (const auto& keyword : food.getKeywords()) {
+        bytes += sizeof(std::string) + keyword.capacity();
+    }
+    for (const auto& component : food.getComponents()) {
+        bytes += approximateFoodSize(component);
+    }
+    return bytes;
+}
+
+// Splits a field on commas, as used by the keyword and component lists
+static std::vector<std::string> splitList(const std::string& field) {
+    std::vector<std::string> items;
+    std::stringstream ss(field);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+// True when the calories field starting at caloriesStart is present and parses like Food::fromString
+static bool hasValidCalories(const std::string& line, size_t caloriesStart) {
+    size_t caloriesEnd = line.find(';', caloriesStart);
+    std::string field = line.substr(caloriesStart, caloriesEnd == std::string::npos ? std::string::npos
+                                                                                    : caloriesEnd - caloriesStart);
+    if (field.empty()) {
+        return false;
+    }
+    try {
+        std::stoi(field);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+// Constructor
+PagedFoodDatabase::PagedFoodDatabase(const std::string& filename, size_t cacheBudgetBytes)
+    : databaseFilename(filename), fileDescriptor(-1), mappedData(nullptr), mappedSize(0),
+      cacheBudgetBytes(cacheBudgetBytes), cacheUsedBytes(0) {
+    loadFromFile();
+}
+
+PagedFoodDatabase::~PagedFoodDatabase() {
+    unmapFile();
+}
+
+void PagedFoodDatabase::unmapFile() {
+    if (mappedData != nullptr) {
+        munmap(const_cast<char*>(mappedData), mappedSize);
+        mappedData = nullptr;
+    }
+    if (fileDescriptor != -1) {
+        close(fileDescriptor);
+        fileDescriptor = -1;
+    }
+    mappedSize = 0;
+}
+
+// Database operations
+bool PagedFoodDatabase::loadFromFile() {
+    unmapFile();
+    records.clear();
+    identifierIndex.clear();
+    keywordIndex.clear();
+    cache.clear();
+    cacheIndex.clear();
+    cacheUsedBytes = 0;
+    
+    fileDescriptor = open(databaseFilename.c_str(), O_RDONLY);
+    if (fileDescriptor == -1) {
+        std::cerr << "Warning: Could not open database file '" << databaseFilename << "' for reading." << std::endl;
+        return false;
+    }
+    
+    struct stat fileInfo;
+    if (fstat(fileDescriptor, &fileInfo) != 0) {
+        std::cerr << "Warning: Could not read size of database file '" << databaseFilename << "'." << std::endl;
+        unmapFile();
+        return false;
+    }
+    
+    // An empty file is a valid, empty database
+    if (fileInfo.st_size == 0) {
+        return true;
+    }
+    
+    mappedSize = static_cast<size_t>(fileInfo.st_size);
+    void* mapping = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Warning: Could not map database file '" << databaseFilename << "'." << std::endl;
+        mappedSize = 0;
+        unmapFile();
+        return false;
+    }
+    mappedData = static_cast<const char*>(mapping);
+    
+    // The index build is one sequential pass; lookups afterwards are random access
+    madvise(mapping, mappedSize, MADV_SEQUENTIAL);
+    if (!buildIndexes()) {
+        records.clear();
+        identifierIndex.clear();
+        keywordIndex.clear();
+        unmapFile();
+        return false;
+    }
+    madvise(mapping, mappedSize, MADV_RANDOM);
+    
+    return true;
+}
+
+bool PagedFoodDatabase::buildIndexes() {
+    size_t skippedLines = 0;
+    size_t lineStart = 0;
+    while (lineStart < mappedSize) {
+        const char* newline = static_cast<const char*>(
+            std::memchr(mappedData + lineStart, '\n', mappedSize - lineStart));
+        size_t lineEnd = newline ? static_cast<size_t>(newline - mappedData) : mappedSize;
+        size_t length = lineEnd - lineStart;
+        if (length > 0 && mappedData[lineStart + length - 1] == '\r') {
+            --length;
+        }
+        
+        // Skip empty lines and comments
+        if (length > 0 && mappedData[lineStart] != '#') {
+            std::string line(mappedData + lineStart, length);
+            
+            // Pipe-delimited feeds would otherwise index nothing at all
+            if (records.empty() && line.find('|') != std::string::npos && line.find(';') == std::string::npos) {
+                std::cerr << "Error: '" << databaseFilename << "' uses the pipe-delimited layout; "
+                          << "import it into a FoodDatabase and save it in the semicolon layout first." << std::endl;
+                return false;
+            }
+            
+            size_t idEnd = line.find(';');
+            size_t keywordsEnd = idEnd == std::string::npos ? std::string::npos : line.find(';', idEnd + 1);
+            
+            // Same checks as FoodDatabase::parseFoodRows: identifier, keywords and calories that
+            // Food::fromString can parse, so decoding a record later can never throw
+            if (keywordsEnd != std::string::npos && idEnd > 0 && hasValidCalories(line, keywordsEnd + 1)) {
+                size_t recordNumber = records.size();
+                records.push_back({lineStart, length});
+                
+                // The first record with a given identifier wins, as with FoodDatabase lookups
+                identifierIndex.emplace(line.substr(0, idEnd), recordNumber);
+                
+                for (const auto& keyword : splitList(line.substr(idEnd + 1, keywordsEnd - idEnd - 1))) {
+                    auto& postings = keywordIndex[keyword];
+                    if (postings.empty() || postings.back() != recordNumber) {
+                        postings.push_back(recordNumber);
+                    }
+                }
+            } else {
+                ++skippedLines;
+            }
+        }
+        
+        lineStart = lineEnd + 1;
+    }
+    
+    if (skippedLines > 0) {
+        std::cerr << "Warning: Skipped " << skippedLines << " malformed lines in '" << databaseFilename << "'." << std::endl;
+    }
+    return true;
+}
+
+std::string PagedFoodDatabase::recordLine(size_t recordNumber) const {
+    const RecordLocation& location = records[recordNumber];
+    return std::string(mappedData + location.offset, location.length);
+}
+
+std::shared_ptr<const Food> PagedFoodDatabase::decodeRecord(size_t recordNumber, int depth) const {
+    std::string line = recordLine(recordNumber);
+    
+    std::vector<std::string> tokens;
+    std::stringstream ss(line);
+    std::string token;
+    while (std::getline(ss, token, ';')) {
+        tokens.push_back(token);
+    }
+    
+    // Composite foods are rebuilt from their components, which are paged in on demand
+    if (tokens.size() >= 5 && tokens[3] == "1" && depth < MAX_COMPOSITE_DEPTH) {
+        std::vector<Food> components;
+        for (const auto& compId : splitList(tokens[4])) {
+            auto found = identifierIndex.find(compId);
+            if (found == identifierIndex.end()) {
+                std::cerr << "Warning: Component '" << compId << "' not found for composite food '" 
+                          << tokens[0] << "'" << std::endl;
+                components.clear();
+                break;
+            }
+            components.push_back(*fetchRecord(found->second, depth + 1));
+        }
+        if (!components.empty()) {
+            return std::make_shared<const Food>(tokens[0], components);
+        }
+    }
+    
+    return std::make_shared<const Food>(Food::fromString(line));
+}
+
+std::shared_ptr<const Food> PagedFoodDatabase::fetchRecord(size_t recordNumber, int depth) const {
+    auto cached = cacheIndex.find(recordNumber);
+    if (cached != cacheIndex.end()) {
+        // Move to the front to mark as most recently used
+        cache.splice(cache.begin(), cache, cached->second);
+        return cached->second->second;
+    }
+    
+    std::shared_ptr<const Food> food = decodeRecord(recordNumber, depth);
+    
+    // Decoding a composite may already have cached this record through a cycle
+    cached = cacheIndex.find(recordNumber);
+    if (cached != cacheIndex.end()) {
+        return cached->second->second;
+    }
+    
+    cache.emplace_front(recordNumber, food);
+    cacheIndex[recordNumber] = cache.begin();
+    cacheUsedBytes += approximateFoodSize(*food);
+    
+    evictOverBudget();
+    return food;
+}
+
+void PagedFoodDatabase::evictOverBudget() const {
+    // Evict least recently used records, always keeping the most recent one
+    while (cacheUsedBytes > cacheBudgetBytes && cache.size() > 1) {
+        const auto& victim = cache.back();
+        cacheUsedBytes -= approximateFoodSize(*victim.second);
+        cacheIndex.erase(victim.first);
+        cache.pop_back();
+    }
+}
+
+std::vector<Food> PagedFoodDatabase::fetchRecords(const std::vector<size_t>& recordNumbers) const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::vector<Food> result;
+    result.reserve(recordNumbers.size());
+    for (size_t recordNumber : recordNumbers) {
+        result.push_back(*fetchRecord(recordNumber));
+    }
+    return result;
+}
+
+// Food operations
+std::shared_ptr<const Food> PagedFoodDatabase::findFoodByIdentifier(const std::string& identifier) const {
+    auto found = identifierIndex.find(identifier);
+    if (found == identifierIndex.end()) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return fetchRecord(found->second);
+}
+
+std::vector<Food> PagedFoodDatabase::findFoodsByKeyword(const std::string& keyword) const {
+    auto found = keywordIndex.find(keyword);
+    if (found == keywordIndex.end()) {
+        return std::vector<Food>();
+    }
+    return fetchRecords(found->second);
+}
+
+std::vector<Food> PagedFoodDatabase::findFoodsByAllKeywords(const std::vector<std::string>& keywords) const {
+    // No keywords matches every food, as with Food::matchAllKeywords
+    if (keywords.empty()) {
+        std::vector<size_t> all(records.size());
+        for (size_t i = 0; i < all.size(); ++i) {
+            all[i] = i;
+        }
+        return fetchRecords(all);
+    }
+    
+    // Intersect the sorted posting lists without touching the mapped records
+    std::vector<size_t> matches;
+    for (size_t i = 0; i < keywords.size(); ++i) {
+        auto found = keywordIndex.find(keywords[i]);
+        if (found == keywordIndex.end()) {
+            return std::vector<Food>();
+        }
+        if (i == 0) {
+            matches = found->second;
+        } else {
+            std::vector<size_t> narrowed;
+            std::set_intersection(matches.begin(), matches.end(),
+                                  found->second.begin(), found->second.end(),
+                                  std::back_inserter(narrowed));
+            matches.swap(narrowed);
+        }
+    }
+    return fetchRecords(matches);
+}
+
+std::vector<Food> PagedFoodDatabase::findFoodsByAnyKeyword(const std::vector<std::string>& keywords) const {
+    // No keywords matches every food, as with Food::matchAnyKeyword
+    if (keywords.empty()) {
+        return findFoodsByAllKeywords(keywords);
+    }
+    
+    // Union of the sorted posting lists keeps the file order of the results
+    std::vector<size_t> matches;
+    for (const auto& keyword : keywords) {
+        auto found = keywordIndex.find(keyword);
+        if (found == keywordIndex.end()) {
+            continue;
+        }
+        std::vector<size_t> merged;
+        std::set_union(matches.begin(), matches.end(),
+                       found->second.begin(), found->second.end(),
+                       std::back_inserter(merged));
+        matches.swap(merged);
+    }
+    return fetchRecords(matches);
+}
+
+// Cache configuration
+void PagedFoodDatabase::setCacheBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cacheBudgetBytes = bytes;
+    evictOverBudget();
+}
+
+size_t PagedFoodDatabase::getCacheBudget() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cacheBudgetBytes;
+}
+
+size_t PagedFoodDatabase::getCacheUsage() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cacheUsedBytes;
+}
+
+// Other operations
+size_t PagedFoodDatabase::size() const {
+    return records.size();
+}
\ No newline at end of file
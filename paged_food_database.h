@@ -0,0 +1,81 @@
+#ifndef PAGED_FOOD_DATABASE_H
+#define PAGED_FOOD_DATABASE_H
+
+#include "food.h"
+#include <vector>
+#include <string>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// Out-of-core, read-only view of a food database file.
+// Records stay in a memory-mapped file; only the identifier and keyword indexes
+// live in RAM, and decoded Food records are kept in a bounded LRU cache.
+// Lookups may run concurrently (the cache is guarded by a mutex); loadFromFile must not
+// run while lookups are in progress. Only the semicolon layout is supported.
+class PagedFoodDatabase {
+private:
+    // Location of one record (a single line) inside the mapped file
+    struct RecordLocation {
+        size_t offset;
+        size_t length;
+    };
+    
+    // Cache entry: record number plus the decoded food
+    typedef std::list<std::pair<size_t, std::shared_ptr<const Food>>> CacheList;
+    
+    std::string databaseFilename;
+    int fileDescriptor;
+    const char* mappedData;
+    size_t mappedSize;
+    
+    std::vector<RecordLocation> records;
+    std::unordered_map<std::string, size_t> identifierIndex;
+    std::unordered_map<std::string, std::vector<size_t>> keywordIndex;
+    
+    // LRU cache of decoded records (most recently used at the front)
+    size_t cacheBudgetBytes;
+    mutable std::mutex cacheMutex;
+    mutable size_t cacheUsedBytes;
+    mutable CacheList cache;
+    mutable std::unordered_map<size_t, CacheList::iterator> cacheIndex;
+    
+    // Helper methods
+    bool buildIndexes();
+    void unmapFile();
+    std::string recordLine(size_t recordNumber) const;
+    std::shared_ptr<const Food> decodeRecord(size_t recordNumber, int depth) const;
+    // Cache helpers below expect cacheMutex to be held by the caller
+    void evictOverBudget() const;
+    std::shared_ptr<const Food> fetchRecord(size_t recordNumber, int depth = 0) const;
+    std::vector<Food> fetchRecords(const std::vector<size_t>& recordNumbers) const;
+    
+public:
+    // Constructor (cacheBudgetBytes bounds the memory held by decoded foods)
+    PagedFoodDatabase(const std::string& filename = "foods.txt", size_t cacheBudgetBytes = 16 * 1024 * 1024);
+    ~PagedFoodDatabase();
+    
+    // The mapping is owned by this object, so it cannot be copied
+    PagedFoodDatabase(const PagedFoodDatabase&) = delete;
+    PagedFoodDatabase& operator=(const PagedFoodDatabase&) = delete;
+    
+    // Database operations
+    bool loadFromFile();
+    
+    // Food operations (returned foods stay valid even after they leave the cache)
+    std::shared_ptr<const Food> findFoodByIdentifier(const std::string& identifier) const;
+    std::vector<Food> findFoodsByKeyword(const std::string& keyword) const;
+    std::vector<Food> findFoodsByAllKeywords(const std::vector<std::string>& keywords) const;
+    std::vector<Food> findFoodsByAnyKeyword(const std::vector<std::string>& keywords) const;
+    
+    // Cache configuration
+    void setCacheBudget(size_t bytes);
+    size_t getCacheBudget() const;
+    size_t getCacheUsage() const;
+    
+    // Other operations
+    size_t size() const;
+};
+
+#endif // PAGED_FOOD_DATABASE_H
\ No newline at end of file
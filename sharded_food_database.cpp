@@ -0,0 +1,339 @@
+#include "sharded_food_database.h"
+#include "stable_hash.h"
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+
+// Runs a search on every shard concurrently and concatenates the results in shard order
+template <typename Search>
+static std::vector<Food> fanOut(const std::vector<FoodDatabase>& shards, Search search) {
+    std::vector<std::future<std::vector<Food>>> pending;
+    pending.reserve(shards.size());
+    for (const auto& shard : shards) {
+        pending.push_back(std::async(std::launch::async, [&shard, &search]() {
+            return search(shard);
+        }));
+    }
+    
+    std::vector<Food> result;
+    for (auto& future : pending) {
+        std::vector<Food> partial = future.get();
+        result.insert(result.end(), partial.begin(), partial.end());
+    }
+    return result;
+}
+
+// Constructor
+ShardedFoodDatabase::ShardedFoodDatabase(const std::string& baseFilename, size_t shardCount)
+    : baseFilename(baseFilename), layoutMismatch(false) {
+    if (shardCount == 0) {
+        shardCount = 1;
+    }
+    
+    shards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards.emplace_back(shardFilename(i), false);
+    }
+    
+    loadFromFile();
+}
+
+size_t ShardedFoodDatabase::shardIndexFor(const std::string& identifier) const {
+    // The hash must not change between runs, or saved shards would no longer be found
+    return static_cast<size_t>(stableHash(identifier)) % shards.size();
+}
+
+FoodDatabase& ShardedFoodDatabase::shardFor(const std::string& identifier) {
+    return shards[shardIndexFor(identifier)];
+}
+
+std::string ShardedFoodDatabase::shardFilename(size_t index) const {
+    return baseFilename + ".shard" + std::to_string(index) + ".txt";
+}
+
+std::string ShardedFoodDatabase::manifestFilename() const {
+    return baseFilename + ".shards";
+}
+
+// Placement depends on the shard count, so files written with a different count
+// cannot be read back correctly
+bool ShardedFoodDatabase::checkShardLayout() const {
+    std::ifstream manifest(manifestFilename());
+    if (manifest.is_open()) {
+        size_t storedCount = 0;
+        if (!(manifest >> storedCount) || storedCount != shards.size()) {
+            std::cerr << "Error: '" << baseFilename << "' was saved with " << storedCount
+                      << " shards but is being opened with " << shards.size() << "." << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
+    // No manifest (older layout): any shard file past the configured count is a mismatch
+    std::filesystem::path base(baseFilename);
+    std::filesystem::path directory = base.has_parent_path() ? base.parent_path() : std::filesystem::path(".");
+    std::string prefix = base.filename().string() + ".shard";
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() <= prefix.size() + 4 || name.compare(0, prefix.size(), prefix) != 0 ||
+            name.compare(name.size() - 4, 4, ".txt") != 0) {
+            continue;
+        }
+        std::string number = name.substr(prefix.size(), name.size() - prefix.size() - 4);
+        if (number.find_first_not_of("0123456789") != std::string::npos) {
+            continue;
+        }
+        // A suffix too long to parse is certainly past the configured count
+        size_t index = 0;
+        auto parsed = std::from_chars(number.data(), number.data() + number.size(), index);
+        if (parsed.ec != std::errc() || index >= shards.size()) {
+            std::cerr << "Error: Found shard file '" << name << "' but '" << baseFilename
+                      << "' is being opened with " << shards.size() << " shards." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ShardedFoodDatabase::writeManifest() const {
+    std::ofstream manifest(manifestFilename());
+    if (!manifest.is_open()) {
+        std::cerr << "Error: Could not open shard manifest '" << manifestFilename() << "' for writing." << std::endl;
+        return false;
+    }
+    manifest << shards.size() << std::endl;
+    return static_cast<bool>(manifest);
+}
+
+// Moves rows that sit on the wrong shard (e.g. hand-edited files) to their home shard.
+// A row whose identifier already exists on its home shard is dropped; the home row is kept
+void ShardedFoodDatabase::rerouteMisplacedFoods() {
+    size_t moved = 0;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        std::vector<Food> misplaced;
+        for (const auto& food : shards[i].getAllFoods()) {
+            if (shardIndexFor(food.getIdentifier()) != i) {
+                misplaced.push_back(food);
+            }
+        }
+        for (const auto& food : misplaced) {
+            shards[i].removeFood(food.getIdentifier());
+            FoodDatabase& home = shardFor(food.getIdentifier());
+            if (home.getFood(food.getIdentifier()) != nullptr) {
+                std::cerr << "Warning: Food '" << food.getIdentifier() << "' in '" << shards[i].getFilename()
+                          << "' conflicts with the row in '" << home.getFilename()
+                          << "'; keeping the one in '" << home.getFilename() << "'." << std::endl;
+                continue;
+            }
+            home.addFood(food);
+            ++moved;
+        }
+    }
+    
+    if (moved > 0) {
+        std::cerr << "Warning: Moved " << moved << " foods to their home shard." << std::endl;
+    }
+}
+
+// Database operations
+bool ShardedFoodDatabase::loadFromFile() {
+    layoutMismatch = !checkShardLayout();
+    if (layoutMismatch) {
+        return false;
+    }
+    
+    // Each shard parses its own file; composites are resolved afterwards
+    // because their components may live on other shards
+    std::vector<std::vector<FoodDatabase::CompositeRelation>> shardRelations(shards.size());
+    std::vector<std::future<bool>> pending;
+    pending.reserve(shards.size());
+    for (size_t i = 0; i < shards.size(); ++i) {
+        pending.push_back(std::async(std::launch::async, [this, i, &shardRelations]() {
+            return shards[i].loadFromFile(shardRelations[i]);
+        }));
+    }
+    
+    bool allLoaded = true;
+    for (auto& future : pending) {
+        allLoaded = future.get() && allLoaded;
+    }
+    
+    rerouteMisplacedFoods();
+    
+    std::vector<FoodDatabase::CompositeRelation> relations;
+    for (const auto& partial : shardRelations) {
+        relations.insert(relations.end(), partial.begin(), partial.end());
+    }
+    if (!relations.empty()) {
+        processCompositeRelations(relations);
+    }
+    
+    return allLoaded;
+}
+
+void ShardedFoodDatabase::processCompositeRelations(const std::vector<FoodDatabase::CompositeRelation>& relations) {
+    for (const auto& relation : relations) {
+        // Find the composite food
+        if (!getFood(relation.foodId)) {
+            continue;
+        }
+        
+        // Find and add all components, looking across every shard
+        std::vector<Food> components;
+        bool allComponentsFound = true;
+        
+        for (const auto& compId : relation.componentIds) {
+            const Food* component = getFood(compId);
+            if (component) {
+                components.push_back(*component);
+            } else {
+                allComponentsFound = false;
+                std::cerr << "Warning: Component '" << compId << "' not found for composite food '" 
+                          << relation.foodId << "'" << std::endl;
+                break;
+            }
+        }
+        
+        if (allComponentsFound && !components.empty()) {
+            // Rebuild the composite food on its own shard, keeping that shard's indexes current
+            addFood(Food(relation.foodId, components));
+        }
+    }
+}
+
+bool ShardedFoodDatabase::saveToFile() const {
+    // Writing now would leave the old layout's extra shard files behind
+    if (layoutMismatch) {
+        std::cerr << "Error: Refusing to save '" << baseFilename << "' with a mismatched shard count." << std::endl;
+        return false;
+    }
+    
+    std::vector<std::future<bool>> pending;
+    pending.reserve(shards.size());
+    for (const auto& shard : shards) {
+        pending.push_back(std::async(std::launch::async, [&shard]() {
+            return shard.saveToFile();
+        }));
+    }
+    
+    bool allSaved = true;
+    for (auto& future : pending) {
+        allSaved = future.get() && allSaved;
+    }
+    return writeManifest() && allSaved;
+}
+
+// Composite food operations
+bool ShardedFoodDatabase::createCompositeFood(const std::string& name, const std::vector<std::string>& componentIds) {
+    // Check if food with this name already exists
+    if (getFood(name) != nullptr) {
+        std::cerr << "Error: Food with name '" << name << "' already exists." << std::endl;
+        return false;
+    }
+    
+    // Find all component foods, wherever they are stored
+    std::vector<Food> components;
+    for (const auto& compId : componentIds) {
+        const Food* component = getFood(compId);
+        if (component) {
+            components.push_back(*component);
+        } else {
+            std::cerr << "Error: Component '" << compId << "' not found." << std::endl;
+            return false;
+        }
+    }
+    
+    if (components.empty()) {
+        std::cerr << "Error: Cannot create composite food with no components." << std::endl;
+        return false;
+    }
+    
+    // Create and add the composite food to the shard that owns its name
+    addFood(Food(name, components));
+    
+    return true;
+}
+
+// Food operations
+void ShardedFoodDatabase::addFood(const Food& food) {
+    shardFor(food.getIdentifier()).addFood(food);
+}
+
+void ShardedFoodDatabase::addFoods(const std::vector<Food>& newFoods) {
+    // Route rows to their shards, then let every shard bulk-append concurrently
+    std::vector<std::vector<Food>> batches(shards.size());
+    for (const auto& food : newFoods) {
+        batches[shardIndexFor(food.getIdentifier())].push_back(food);
+    }
+    
+    std::vector<std::future<void>> pending;
+    pending.reserve(shards.size());
+    for (size_t i = 0; i < shards.size(); ++i) {
+        if (batches[i].empty()) {
+            continue;
+        }
+        pending.push_back(std::async(std::launch::async, [this, i, &batches]() {
+            shards[i].addFoods(batches[i]);
+        }));
+    }
+    for (auto& future : pending) {
+        future.get();
+    }
+}
+
+bool ShardedFoodDatabase::removeFood(const std::string& identifier) {
+    return shardFor(identifier).removeFood(identifier);
+}
+
+Food* ShardedFoodDatabase::findFoodByIdentifier(const std::string& identifier) {
+    return shardFor(identifier).findFoodByIdentifier(identifier);
+}
+
+const Food* ShardedFoodDatabase::getFood(const std::string& identifier) const {
+    return shards[shardIndexFor(identifier)].getFood(identifier);
+}
+
+std::vector<Food> ShardedFoodDatabase::findFoodsByKeyword(const std::string& keyword) const {
+    return fanOut(shards, [&keyword](const FoodDatabase& shard) {
+        return shard.findFoodsByKeyword(keyword);
+    });
+}
+
+std::vector<Food> ShardedFoodDatabase::findFoodsByAllKeywords(const std::vector<std::string>& keywords) const {
+    return fanOut(shards, [&keywords](const FoodDatabase& shard) {
+        return shard.findFoodsByAllKeywords(keywords);
+    });
+}
+
+std::vector<Food> ShardedFoodDatabase::findFoodsByAnyKeyword(const std::vector<std::string>& keywords) const {
+    return fanOut(shards, [&keywords](const FoodDatabase& shard) {
+        return shard.findFoodsByAnyKeyword(keywords);
+    });
+}
+
+// Other operations
+size_t ShardedFoodDatabase::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        total += shard.size();
+    }
+    return total;
+}
+
+size_t ShardedFoodDatabase::shardCount() const {
+    return shards.size();
+}
+
+std::vector<Food> ShardedFoodDatabase::getAllFoods() const {
+    std::vector<Food> result;
+    result.reserve(size());
+    for (const auto& shard : shards) {
+        for (size_t position = 0; position < shard.size(); ++position) {
+            result.push_back(shard.getFoodAt(position));
+        }
+    }
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef SHARDED_FOOD_DATABASE_H
+#define SHARDED_FOOD_DATABASE_H
+
+#include "food.h"
+#include "food_database.h"
+#include <vector>
+#include <string>
+
+// Partitions foods across several FoodDatabase shards by identifier hash.
+// Each shard owns its own file; loads, saves and searches run on all shards in parallel.
+class ShardedFoodDatabase {
+private:
+    std::vector<FoodDatabase> shards;
+    std::string baseFilename;
+    // Set when the files on disk were written with another shard count; saving is refused
+    bool layoutMismatch;
+    
+    // Helper methods for shard routing
+    size_t shardIndexFor(const std::string& identifier) const;
+    FoodDatabase& shardFor(const std::string& identifier);
+    std::string shardFilename(size_t index) const;
+    std::string manifestFilename() const;
+    bool checkShardLayout() const;
+    bool writeManifest() const;
+    void rerouteMisplacedFoods();
+    void processCompositeRelations(const std::vector<FoodDatabase::CompositeRelation>& relations);
+    
+public:
+    // Constructor (shard files are named <base>.shard<N>.txt, e.g. foods.shard0.txt;
+    // the shard count is recorded in <base>.shards and must match on later loads)
+    ShardedFoodDatabase(const std::string& baseFilename = "foods", size_t shardCount = 4);
+    
+    // Database operations
+    bool loadFromFile();
+    bool saveToFile() const;
+    
+    // Food operations
+    void addFood(const Food& food);
+    void addFoods(const std::vector<Food>& newFoods);
+    bool removeFood(const std::string& identifier);
+    Food* findFoodByIdentifier(const std::string& identifier);
+    // Read-only lookup that never copies a chunk shared with a background save
+    const Food* getFood(const std::string& identifier) const;
+    std::vector<Food> findFoodsByKeyword(const std::string& keyword) const;
+    std::vector<Food> findFoodsByAllKeywords(const std::vector<std::string>& keywords) const;
+    std::vector<Food> findFoodsByAnyKeyword(const std::vector<std::string>& keywords) const;
+    
+    // Composite food operations
+    bool createCompositeFood(const std::string& name, const std::vector<std::string>& componentIds);
+    
+    // Other operations
+    size_t size() const;
+    size_t shardCount() const;
+    std::vector<Food> getAllFoods() const;
+};
+
+#endif // SHARDED_FOOD_DATABASE_H
\ No newline at end of file
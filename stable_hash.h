@@ -0,0 +1,19 @@
+#ifndef STABLE_HASH_H
+#define STABLE_HASH_H
+
+#include <cstdint>
+#include <string>
+
+// FNV-1a string hash. Unlike std::hash it gives the same value on every run and
+// compiler, so it is safe for anything that is persisted or must be reproducible
+// (shard placement, similarity signatures).
+inline uint64_t stableHash(const std::string& text) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+#endif // STABLE_HASH_H
\ No newline at end of file